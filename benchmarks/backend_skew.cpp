@@ -0,0 +1,101 @@
+#include "../include/backend.h"
+#include "../include/formatter.h"
+#include "../include/logger.h"
+#include "../include/sink.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Skewed producer load on a two-shard Backend: every busy logger is pinned
+// to shard 0 while shard 1 only serves a near-idle one. Compares drain time
+// and producer back-pressure with and without work stealing.
+
+namespace {
+
+using SkewLogger = logger::Logger<1 << 14>;
+
+constexpr int kHotLoggers = 4;
+constexpr std::size_t kHotRecords = 200000; // per hot logger
+constexpr std::size_t kIdleRecords = 1000;
+
+// Counts bytes; the shard output cost is formatting plus this.
+class CountingSink final : public logger::Sink {
+  public:
+    void Write(const char *, std::size_t len) override {
+        bytes += len;
+        ++records;
+    }
+    void Flush() override {}
+    std::uint64_t bytes = 0;
+    std::uint64_t records = 0;
+};
+
+void Run(bool work_stealing) {
+    logger::TextFormatter formatter;
+    CountingSink outputs[2];
+    logger::Backend backend(2, work_stealing);
+    for (std::size_t i = 0; i < 2; ++i) {
+        backend.SetShardDestination(i, formatter, outputs[i]);
+    }
+    backend.Start();
+
+    std::vector<std::unique_ptr<SkewLogger>> loggers;
+    for (int i = 0; i < kHotLoggers; ++i) {
+        char name[16];
+        std::snprintf(name, sizeof(name), "hot%d", i);
+        loggers.push_back(std::make_unique<SkewLogger>(backend, name, 0));
+    }
+    loggers.push_back(std::make_unique<SkewLogger>(backend, "idle", 1));
+    for (auto &instance : loggers) {
+        instance->Start();
+    }
+
+    std::uint64_t full_retries[kHotLoggers + 1] = {};
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> producers;
+    for (int i = 0; i <= kHotLoggers; ++i) {
+        producers.emplace_back([&, i] {
+            const std::size_t count = i < kHotLoggers ? kHotRecords : kIdleRecords;
+            for (std::size_t n = 0; n < count; ++n) {
+                while (loggers[i]->LogFormat(logger::Level::Info, "order id=%zu px=%zu", n, 100 + (n % 7)) ==
+                       logger::LogResult::BufferFull) {
+                    ++full_retries[i];
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (std::thread &producer : producers) {
+        producer.join();
+    }
+    loggers.clear(); // waits for the shards to drain every lane
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    backend.Stop();
+
+    std::uint64_t retries = 0;
+    for (std::uint64_t count : full_retries) {
+        retries += count;
+    }
+    const logger::ShardStats owner = backend.GetShardStats(0);
+    const logger::ShardStats peer = backend.GetShardStats(1);
+    const double total = static_cast<double>(owner.records + peer.records);
+    std::printf("%-9s %8.0f records  %7.2f ms  %6.2f Mrec/s  full-retries=%-9llu shard0=%llu shard1=%llu "
+                "steals=%llu stolen=%llu\n",
+                work_stealing ? "stealing" : "static", total, seconds * 1e3, total / seconds / 1e6,
+                static_cast<unsigned long long>(retries), static_cast<unsigned long long>(owner.records),
+                static_cast<unsigned long long>(peer.records), static_cast<unsigned long long>(peer.steals),
+                static_cast<unsigned long long>(peer.stolen_records));
+}
+
+} // namespace
+
+int main() {
+    Run(false);
+    Run(true);
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include "../include/binary_log.h"
+#include "../include/parallel_decoder.h"
+#include "../include/record.h"
+#include "../include/sink.h"
+#include "../internal/platform.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+
+// Binary -> text decoding throughput of ParallelDecoder for 1..N threads.
+// Writes a synthetic binary log first, then decodes it into a sink that
+// only counts bytes, so the numbers are rendering + reorder cost alone.
+
+namespace {
+
+constexpr const char *kPath = "/tmp/lll_decoder_throughput.lllb";
+constexpr std::size_t kRecords = 2000000;
+
+class CountingSink final : public logger::Sink {
+  public:
+    void Write(const char *, std::size_t len) override {
+        bytes += len;
+    }
+    void Flush() override {}
+    std::uint64_t bytes = 0;
+};
+
+void WriteInput() {
+    logger::BinaryFormatter formatter;
+    logger::BinaryFileSink sink(kPath);
+    logger::LogRecord record{};
+    record.sample_rate = 1;
+    char encoded[logger::kFormatScratchSize];
+    std::uint64_t tsc = logger::internal::ReadTsc();
+    for (std::size_t i = 0; i < kRecords; ++i) {
+        record.level = i % 50 == 0 ? logger::Level::Warn : logger::Level::Info;
+        record.timestamp = tsc += 700;
+#if LOGGER_ENABLE_THREAD_ID
+        record.thread_id = 140245 + i % 4;
+#endif
+#if LOGGER_ENABLE_SOURCE_LOCATION
+        record.file = "src/order_gateway.cpp";
+        record.function = "OnExecutionReport";
+        record.line = static_cast<std::int32_t>(100 + i % 40);
+#endif
+        record.FormatMessage("exec id=%zu sym=ES px=%zu.%02zu qty=%zu", i, 4000 + i % 50, i % 100, 1 + i % 20);
+        sink.Write(encoded, formatter.FormatRecord(record, encoded, sizeof(encoded)));
+    }
+}
+
+} // namespace
+
+int main() {
+    WriteInput();
+    logger::BinaryLogReader reader;
+    if (!reader.Open(kPath)) {
+        std::fprintf(stderr, "decoder_throughput: cannot open %s\n", kPath);
+        return 1;
+    }
+
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    std::printf("%zu records, %zu blocks, %u hardware threads\n", kRecords, reader.BlockCount(), cores);
+    for (unsigned threads = 1; threads <= std::max(4u, cores); threads *= 2) {
+        CountingSink out;
+        logger::ParallelDecoder decoder(logger::DecodeOptions{threads, 0});
+        const logger::DecodeStats stats = decoder.Decode(reader, out);
+        const double seconds = static_cast<double>(stats.elapsed_ns) / 1e9;
+        std::printf("threads=%-3u %7.1f ms  %6.2f GB/s in  %6.2f GB/s out  %6.2f Mrec/s\n", threads, seconds * 1e3,
+                    static_cast<double>(stats.input_bytes) / seconds / 1e9,
+                    static_cast<double>(stats.output_bytes) / seconds / 1e9,
+                    static_cast<double>(stats.records) / seconds / 1e6);
+    }
+    std::remove(kPath);
+    return 0;
+}
@@ -0,0 +1,198 @@
+#include "../include/flush_policy.h"
+#include "../include/formatter.h"
+#include "../include/logger.h"
+#include "../include/sink.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+// End-to-end producer -> consumer -> sink run, comparing consumer flush
+// policies. The sink buffers like stdio and counts the write calls it
+// would issue, so "syscalls/record" shows how well each policy batches.
+//
+// Also reports the machine code one LogFormat() call site adds to its
+// caller, so growth of the inlined fast path (i-cache footprint) shows up,
+// and the consumer's drain rate over a full ring. The drain rate is built
+// with and without consumer prefetch (log_throughput_noprefetch sets
+// LOGGER_CONSUMER_PREFETCH_SLOTS=0).
+
+namespace {
+
+constexpr std::size_t kRingCapacity = 1 << 14;
+constexpr std::size_t kBurstRecords = 500000;
+constexpr std::size_t kModerateRecords = 20000;
+
+// stdio-like sink: 64 KiB buffer, one unbuffered fwrite (one write syscall) per drain.
+class SyscallCountingSink final : public logger::Sink {
+  public:
+    SyscallCountingSink() : file_(std::fopen("/dev/null", "wb")) {
+        if (file_) {
+            std::setvbuf(file_, nullptr, _IONBF, 0);
+        }
+    }
+
+    ~SyscallCountingSink() override {
+        if (file_) {
+            std::fclose(file_);
+        }
+    }
+
+    void Write(const char *data, std::size_t len) override {
+        if (used_ + len > sizeof(buffer_)) {
+            Drain();
+        }
+        std::memcpy(buffer_ + used_, data, len);
+        used_ += len;
+        ++records_;
+    }
+
+    void Flush() override {
+        Drain();
+    }
+
+    std::uint64_t Syscalls() const {
+        return syscalls_;
+    }
+
+    std::uint64_t Records() const {
+        return records_;
+    }
+
+  private:
+    void Drain() {
+        if (used_ == 0) {
+            return;
+        }
+        if (file_) {
+            (void)std::fwrite(buffer_, 1, used_, file_);
+        }
+        ++syscalls_;
+        used_ = 0;
+    }
+
+    std::FILE *file_;
+    char buffer_[64 * 1024];
+    std::size_t used_ = 0;
+    std::uint64_t syscalls_ = 0;
+    std::uint64_t records_ = 0;
+};
+
+// Sleep between records to model a moderate message rate (0 = full speed).
+// Sleeping rather than spinning leaves the consumer a core even on one CPU.
+void Pace(std::chrono::microseconds gap) {
+    if (gap.count() != 0) {
+        std::this_thread::sleep_for(gap);
+    }
+}
+
+void Run(const char *name, const logger::FlushPolicy &policy, std::size_t count, std::chrono::microseconds gap) {
+    logger::TextFormatter formatter;
+    SyscallCountingSink sink;
+    std::uint64_t dropped = 0;
+    double seconds = 0;
+    {
+        auto instance = std::make_unique<logger::Logger<kRingCapacity>>(formatter, sink, policy);
+        instance->Start();
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < count; ++i) {
+            if (instance->LogFormat(logger::Level::Info, "order id=%zu px=%zu qty=%zu", i, 100 + (i % 7), i % 900) !=
+                logger::LogResult::Success) {
+                ++dropped;
+            }
+            Pace(gap);
+        }
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        // Let the consumer drain before stopping.
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        instance.reset();
+    }
+
+    const double records = static_cast<double>(sink.Records());
+    std::printf("%-8s %-10s %9.0f records  %8llu syscalls  %.4f syscalls/record  %6.2f Mrec/s  dropped=%llu\n",
+                name, gap.count() == 0 ? "burst" : "moderate", records,
+                static_cast<unsigned long long>(sink.Syscalls()), records > 0 ? sink.Syscalls() / records : 0.0,
+                static_cast<double>(count) / seconds / 1e6, static_cast<unsigned long long>(dropped));
+}
+
+// Fill the ring while the consumer is stopped, then time how fast it empties it.
+void RunDrain() {
+    logger::TextFormatter formatter;
+    SyscallCountingSink sink;
+    double seconds = 0;
+    std::size_t filled = 0;
+    {
+        auto instance = std::make_unique<logger::Logger<kRingCapacity>>(formatter, sink);
+        while (instance->LogFormat(logger::Level::Info, "order id=%zu px=%zu qty=%zu", filled, 100 + (filled % 7),
+                                   filled % 900) == logger::LogResult::Success) {
+            ++filled;
+        }
+        const auto start = std::chrono::steady_clock::now();
+        instance->Start();
+        while (instance->PendingCount() != 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        instance.reset();
+    }
+    std::printf("drain    prefetch=%d %7zu records  %6.2f Mrec/s\n", LOGGER_CONSUMER_PREFETCH_SLOTS, filled,
+                static_cast<double>(filled) / seconds / 1e6);
+}
+
+#if defined(__ELF__) && defined(LOGGER_COMPILER_GCC_COMPATIBLE)
+// Each function lives alone in a named section; the linker defines
+// __start_<section> / __stop_<section> around it, so the difference is its
+// size in bytes. Out-of-line helpers (cold paths) land in .text and are not
+// counted: the figure is what every call site pays.
+extern "C" const char __start_lll_one_callsite[], __stop_lll_one_callsite[];
+extern "C" const char __start_lll_nine_callsites[], __stop_lll_nine_callsites[];
+
+using SizedLogger = logger::Logger<kRingCapacity>;
+
+__attribute__((noinline, used, section("lll_one_callsite"))) void OneCallSite(SizedLogger &log, std::size_t i) {
+    (void)log.LogFormat(logger::Level::Info, "order id=%zu", i);
+}
+
+__attribute__((noinline, used, section("lll_nine_callsites"))) void NineCallSites(SizedLogger &log, std::size_t i) {
+    (void)log.LogFormat(logger::Level::Info, "order id=%zu", i);
+    (void)log.LogFormat(logger::Level::Info, "fill id=%zu", i);
+    (void)log.LogFormat(logger::Level::Info, "cancel id=%zu", i);
+    (void)log.LogFormat(logger::Level::Warn, "reject id=%zu", i);
+    (void)log.LogFormat(logger::Level::Info, "ack id=%zu", i);
+    (void)log.LogFormat(logger::Level::Info, "replace id=%zu", i);
+    (void)log.LogFormat(logger::Level::Error, "bust id=%zu", i);
+    (void)log.LogFormat(logger::Level::Info, "expire id=%zu", i);
+    (void)log.LogFormat(logger::Level::Debug, "quote id=%zu", i);
+}
+
+void ReportCallSiteSize() {
+    const std::size_t one = static_cast<std::size_t>(__stop_lll_one_callsite - __start_lll_one_callsite);
+    const std::size_t nine = static_cast<std::size_t>(__stop_lll_nine_callsites - __start_lll_nine_callsites);
+    std::printf("code size: 1 call site %zu bytes, 9 call sites %zu bytes, %.0f bytes per extra call site\n", one,
+                nine, static_cast<double>(nine - one) / 8.0);
+}
+#else
+void ReportCallSiteSize() {
+    std::printf("code size: not measured (needs an ELF toolchain)\n");
+}
+#endif
+
+} // namespace
+
+int main() {
+    const logger::FlushPolicy eager = logger::FlushPolicy::Eager();
+    const logger::FlushPolicy batched{};
+    ReportCallSiteSize();
+    for (int i = 0; i < 3; ++i) {
+        RunDrain();
+    }
+    Run("eager", eager, kModerateRecords, std::chrono::microseconds(10));
+    Run("batched", batched, kModerateRecords, std::chrono::microseconds(10));
+    Run("eager", eager, kBurstRecords, std::chrono::microseconds(0));
+    Run("batched", batched, kBurstRecords, std::chrono::microseconds(0));
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include "../include/record.h"
+#include "../internal/ring_buffer.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+// Cost of ring writes to a cache-sensitive producer. Between pushes the
+// producer walks a 1 MiB working set that fits a 2 MiB L2; ring slots it writes
+// (several MiB in total) compete with it for the same cache. Built twice by
+// CMake, with LOGGER_RING_NONTEMPORAL 0 and 1; compare the "work" column.
+//
+// The ring is drained by the same thread whenever it fills (untimed; once
+// per 4096 records), so the figures do not depend on a second core.
+
+namespace {
+
+constexpr std::size_t kRingCapacity = 1 << 12; // 4096 slots of sizeof(LogRecord) bytes, up to StoredSize() written
+constexpr std::size_t kWorkingSetBytes = 1024 * 1024;
+constexpr std::size_t kTouchesPerRecord = 64;
+constexpr std::size_t kRecords = 1000000;
+
+using Clock = std::chrono::steady_clock;
+using Ring = logger::internal::SpscRingBuffer<logger::LogRecord, kRingCapacity>;
+
+struct Result {
+    double work_ns = 0; // producer work per record
+    double push_ns = 0; // TryPush per record
+    std::uint64_t checksum = 0;
+};
+
+Result Run(const char *name) {
+    auto ring = std::make_unique<Ring>();
+    std::vector<std::uint64_t> working_set(kWorkingSetBytes / sizeof(std::uint64_t), 1);
+    const std::size_t mask = working_set.size() - 1;
+
+    logger::LogRecord record{};
+    record.level = logger::Level::Info;
+    record.sample_rate = 1;
+    record.SetMessage("order id=123456 px=101.25 qty=300 side=B venue=XNAS");
+
+    logger::LogRecord popped;
+    Result result;
+    Clock::duration work{};
+    Clock::duration push{};
+    std::size_t cursor = 0;
+    for (std::size_t i = 0; i < kRecords; ++i) {
+        if (ring->FreeSlots() == 0) {
+            while (ring->TryPop(popped)) {
+            }
+        }
+        const Clock::time_point start = Clock::now();
+        // Pseudo-random walk: mostly cache misses once the working set is evicted.
+        for (std::size_t t = 0; t < kTouchesPerRecord; ++t) {
+            cursor = (cursor * 2862933555777941757ULL + 3037000493ULL) & mask;
+            working_set[cursor] += t;
+            result.checksum += working_set[cursor];
+        }
+        const Clock::time_point middle = Clock::now();
+        record.timestamp = i;
+        (void)ring->TryPush(record);
+        const Clock::time_point end = Clock::now();
+        work += middle - start;
+        push += end - middle;
+    }
+    result.work_ns = std::chrono::duration<double, std::nano>(work).count() / kRecords;
+    result.push_ns = std::chrono::duration<double, std::nano>(push).count() / kRecords;
+    std::printf("%-12s work %7.1f ns/record  push %7.1f ns/record  (slot %zu bytes, checksum %llu)\n", name,
+                result.work_ns, result.push_ns, sizeof(logger::LogRecord),
+                static_cast<unsigned long long>(result.checksum));
+    return result;
+}
+
+} // namespace
+
+int main() {
+#if LOGGER_RING_NONTEMPORAL && LOGGER_HAS_NONTEMPORAL
+    const char *name = "nontemporal";
+#else
+    const char *name = "temporal";
+#endif
+    Run(name);
+    Run(name);
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include "../include/compressed_sink.h"
+#include "../include/formatter.h"
+#include "../include/record.h"
+#include "../include/sink.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <vector>
+
+// Measures what each sink costs the consumer thread for realistic
+// TextFormatter output: wall time, process CPU time and (for the
+// compressed sink) compression ratio and helper-thread compression time.
+
+namespace {
+
+constexpr std::size_t kLineCount = 2000000;
+
+struct Lines {
+    std::vector<char> bytes;
+    std::vector<std::size_t> offsets;
+};
+
+Lines FormatLines() {
+    logger::TextFormatter formatter;
+    logger::LogRecord record{};
+    Lines lines;
+    lines.bytes.reserve(kLineCount * 96);
+    lines.offsets.reserve(kLineCount + 1);
+    char buffer[512];
+    for (std::size_t i = 0; i < kLineCount; ++i) {
+        record.level = (i % 50 == 0) ? logger::Level::Warn : logger::Level::Info;
+        record.timestamp = 1000000 + i * 733;
+        record.sample_rate = 1;
+#if LOGGER_ENABLE_THREAD_ID
+        record.thread_id = 1 + (i % 4);
+#endif
+#if LOGGER_ENABLE_SOURCE_LOCATION
+        record.file = "order_gateway.cpp";
+        record.function = "OnExecutionReport";
+        record.line = 214;
+#endif
+        (void)record.FormatMessage("exec id=%zu px=%zu.%02zu qty=%zu venue=XNAS", i, 100 + (i % 7), i % 100, (i * 13) % 900);
+        const std::size_t len = formatter.FormatRecord(record, buffer, sizeof(buffer));
+        lines.offsets.push_back(lines.bytes.size());
+        lines.bytes.insert(lines.bytes.end(), buffer, buffer + len);
+    }
+    lines.offsets.push_back(lines.bytes.size());
+    return lines;
+}
+
+struct Result {
+    double wall_s;
+    double cpu_s;
+};
+
+Result Run(logger::Sink &sink, const Lines &lines) {
+    const auto wall0 = std::chrono::steady_clock::now();
+    const std::clock_t cpu0 = std::clock();
+    for (std::size_t i = 0; i < kLineCount; ++i) {
+        sink.Write(lines.bytes.data() + lines.offsets[i], lines.offsets[i + 1] - lines.offsets[i]);
+        if (i % 4096 == 4095) {
+            sink.Flush();
+        }
+    }
+    sink.Flush();
+    const auto wall1 = std::chrono::steady_clock::now();
+    const std::clock_t cpu1 = std::clock();
+    return Result{std::chrono::duration<double>(wall1 - wall0).count(),
+                  static_cast<double>(cpu1 - cpu0) / CLOCKS_PER_SEC};
+}
+
+void Report(const char *name, const Result &r, std::size_t bytes) {
+    const double mb = static_cast<double>(bytes) / (1024.0 * 1024.0);
+    std::printf("%-22s %8.1f MB/s consumer  %6.3f s wall  %6.3f s cpu\n", name, mb / r.wall_s, r.wall_s, r.cpu_s);
+}
+
+} // namespace
+
+int main() {
+    const Lines lines = FormatLines();
+    const std::size_t bytes = lines.bytes.size();
+    std::printf("input: %zu lines, %.1f MB of TextFormatter output\n", kLineCount,
+                static_cast<double>(bytes) / (1024.0 * 1024.0));
+
+    {
+        logger::FileSink sink("sink_bench_plain.log", "wb");
+        Report("FileSink", Run(sink, lines), bytes);
+    }
+
+    const logger::internal::BlockCodec codecs[] = {logger::internal::BlockCodec::Lz4,
+                                                    logger::internal::BlockCodec::Zstd};
+    for (logger::internal::BlockCodec codec : codecs) {
+        if (codec == logger::internal::BlockCodec::Zstd && !logger::internal::ZstdAvailable()) {
+            std::printf("CompressedFileSink/zstd  skipped (built without zstd)\n");
+            continue;
+        }
+        logger::CompressedSinkOptions options;
+        options.codec = codec;
+        logger::CompressionStats stats{};
+        Result result{};
+        {
+            logger::CompressedFileSink sink("sink_bench.lllz", options);
+            result = Run(sink, lines);
+            // Destructor drains the helper; stats are final once it returns.
+            stats = sink.Stats();
+        }
+        const char *name = (codec == logger::internal::BlockCodec::Lz4) ? "CompressedFileSink/lz4" : "CompressedFileSink/zstd";
+        Report(name, result, bytes);
+        const double ratio = stats.stored_bytes ? static_cast<double>(stats.raw_bytes) / static_cast<double>(stats.stored_bytes) : 0.0;
+        const double mb = static_cast<double>(stats.raw_bytes) / (1024.0 * 1024.0);
+        std::printf("%-22s ratio %.2fx  blocks %llu  compress %.1f MB/s (%.2f ms CPU per MB)  consumer waits %llu\n", "",
+                    ratio, static_cast<unsigned long long>(stats.blocks),
+                    stats.compress_ns ? mb / (static_cast<double>(stats.compress_ns) * 1e-9) : 0.0,
+                    mb > 0 ? static_cast<double>(stats.compress_ns) * 1e-6 / mb : 0.0,
+                    static_cast<unsigned long long>(stats.consumer_waits));
+    }
+
+    std::remove("sink_bench_plain.log");
+    std::remove("sink_bench.lllz");
+    return 0;
+}
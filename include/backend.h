@@ -0,0 +1,214 @@
+/**
+ * @file backend.h
+ * @brief Consumer threads shared by many named loggers
+ *
+ * Defines the Backend, which drains the channels of every Logger
+ * registered with it from one or more shard threads, instead of one
+ * Consumer thread per Logger. Each shard owns a disjoint set of channels
+ * and may own its own output (e.g. one file per shard) so formatting and
+ * I/O scale with the number of shards.
+ *
+ * RESPONSIBILITIES:
+ * - Register/unregister channels at runtime without locks
+ * - Assign each channel to exactly one shard (SPSC invariant per ring)
+ * - Drain channels fairly: each pass splits LOGGER_BACKEND_PASS_BUDGET
+ *   across a shard's channels in proportion to their backlog
+ * - Optionally write a per-shard ordering index ({tsc, shard, lane, offset})
+ * - Optionally let idle shards steal batches from overloaded peers' channels
+ *   (a per-channel ownership token keeps one drainer per ring at a time)
+ * - Hybrid spin/sleep wait when a shard is idle
+ *
+ * ANTI-RESPONSIBILITIES:
+ * - No ownership of channels (Loggers own them)
+ * - No ownership of shard formatters, sinks or index sinks (references only)
+ * - No formatting or I/O (delegated to Routers)
+ */
+
+#ifndef LOGGER_BACKEND_H
+#define LOGGER_BACKEND_H
+
+#include "../internal/cacheline.h"
+#include "channel.h"
+#include "config.h"
+#include "flush_policy.h"
+#include "formatter.h"
+#include "router.h"
+#include "sink.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace logger {
+
+/**
+ * @brief Per-shard drain totals (safe to read from any thread)
+ */
+struct ShardStats {
+    std::uint64_t records;        // Records drained by this shard (own and stolen)
+    std::uint64_t steals;         // Batches stolen from other shards' channels
+    std::uint64_t stolen_records; // Records in those batches
+};
+
+/**
+ * @brief Shared consumer threads for many loggers
+ *
+ * Loggers constructed with a Backend register their channel on Start()
+ * and unregister it on Stop(). Shard outputs and indexes must be set
+ * before Start(). The Backend must outlive its loggers.
+ */
+class Backend {
+  public:
+    /**
+     * @param shard_count Number of consumer threads (clamped to [1, LOGGER_MAX_BACKEND_SHARDS])
+     * @param work_stealing Let idle shards drain batches from channels of
+     *        other shards whose backlog reaches LOGGER_BACKEND_STEAL_MIN_BACKLOG.
+     *        Per-lane order is kept; records of a shard-output channel stolen by
+     *        another shard land in the thief's output (use the ordering index).
+     */
+    explicit Backend(std::size_t shard_count = 1, bool work_stealing = false) noexcept;
+
+    /**
+     * @brief Stops the backend threads (if running)
+     */
+    ~Backend();
+
+    // Non-copyable, Non-movable
+    Backend(const Backend &) = delete;
+    Backend &operator=(const Backend &) = delete;
+    Backend(Backend &&) = delete;
+    Backend &operator=(Backend &&) = delete;
+
+    /**
+     * @brief Give a shard its own output, used by loggers without sinks of their own
+     * @return false if the backend is running or the shard is out of range
+     */
+    bool SetShardDestination(std::size_t shard, Formatter &formatter, Sink &sink,
+                             const FlushPolicy &flush_policy = FlushPolicy{}) noexcept;
+
+    /**
+     * @brief Write one IndexEntry per record of the shard output to `index_sink`
+     *
+     * Offsets are bytes delivered by the shard router, i.e. file offsets
+     * when the shard output is a single file. MergeShardIndexes() combines
+     * the per-shard indexes into global timestamp order.
+     *
+     * @return false if the backend is running, the shard is out of range or has no output
+     */
+    bool SetShardIndex(std::size_t shard, Sink &index_sink) noexcept;
+
+    /**
+     * @brief Start the shard threads (no-op if already running)
+     */
+    void Start();
+
+    /**
+     * @brief Stop and join the shard threads, flushing every output
+     */
+    void Stop();
+
+    bool IsRunning() const noexcept {
+        return is_running_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Add a channel to the drain set (any thread)
+     * @param channel Channel to drain
+     * @param shard Shard that owns the channel, or -1 for round-robin
+     * @return false if no slot is free, the shard is invalid, or the channel
+     *         shares output with a shard that has none
+     */
+    bool Register(Channel &channel, int shard = -1) noexcept;
+
+    /**
+     * @brief Remove a channel (any thread)
+     *
+     * On return no shard thread touches the channel, so the caller may
+     * drain or destroy it. Channels writing to a shard output are drained
+     * into that output first (by the shard when running, else here).
+     */
+    void Unregister(Channel &channel) noexcept;
+
+    /**
+     * @brief Number of registered channels
+     */
+    std::size_t ChannelCount() const noexcept;
+
+    std::size_t ShardCount() const noexcept {
+        return shard_count_;
+    }
+
+    /**
+     * @brief Drain and steal totals of one shard
+     */
+    ShardStats GetShardStats(std::size_t shard) const noexcept;
+
+  private:
+    static constexpr std::uint32_t kNoOwner = ~std::uint32_t{0};
+
+    struct alignas(internal::kCacheLineSize) Slot {
+        std::atomic<Channel *> channel{nullptr};
+        std::atomic<std::uint32_t> shard{0};
+        // Ownership token (work stealing only): shard currently draining the channel.
+        std::atomic<std::uint32_t> owner{kNoOwner};
+    };
+
+    struct alignas(internal::kCacheLineSize) Shard {
+        // Odd while the shard thread is inside a pass. Unregister() clears a
+        // slot and then waits for any pass that might have seen it to finish
+        // (Dekker-style: both sides store, then load, with seq_cst).
+        std::atomic<std::uint64_t> pass_seq{0};
+        std::unique_ptr<Router> router; // shard output, null if none
+        FlushController flush;
+        ShardIndex index;
+        ChannelOutput output;
+        std::thread thread;
+        // Written by the shard thread only.
+        std::atomic<std::uint64_t> records{0};
+        std::atomic<std::uint64_t> steals{0};
+        std::atomic<std::uint64_t> stolen_records{0};
+    };
+
+    void Loop(std::uint32_t shard_id);
+    std::size_t RunPass(Shard &shard, std::uint32_t shard_id, char *scratch, std::size_t capacity);
+    std::size_t Steal(Shard &shard, std::uint32_t shard_id, char *scratch, std::size_t capacity);
+    bool AcquireToken(Slot &slot, std::uint32_t shard_id) noexcept {
+        if (!work_stealing_) {
+            return true;
+        }
+        std::uint32_t free = kNoOwner;
+        return slot.owner.compare_exchange_strong(free, shard_id, std::memory_order_acquire,
+                                                  std::memory_order_relaxed);
+    }
+    void ReleaseToken(Slot &slot) noexcept {
+        if (work_stealing_) {
+            slot.owner.store(kNoOwner, std::memory_order_release);
+        }
+    }
+    ChannelOutput &OutputFor(Channel &channel, Shard &shard) noexcept {
+        return channel.SharesOutput() ? shard.output : channel.OwnOutput();
+    }
+
+    Slot slots_[LOGGER_MAX_BACKEND_CHANNELS];
+    Shard shards_[LOGGER_MAX_BACKEND_SHARDS];
+    std::size_t shard_count_;
+    bool work_stealing_;
+    std::atomic<std::uint32_t> next_shard_{0};
+    std::atomic<bool> is_running_{false};
+};
+
+/**
+ * @brief Merge per-shard index files into one index sorted by timestamp
+ *
+ * Offline helper for tools: reads every IndexEntry of `index_paths`, sorts
+ * them by (timestamp, shard, offset) and writes them to `out_path`.
+ *
+ * @return false if a file cannot be read or written
+ */
+bool MergeShardIndexes(const char *const *index_paths, std::size_t count, const char *out_path);
+
+} // namespace logger
+
+#endif // LOGGER_BACKEND_H
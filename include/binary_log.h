@@ -0,0 +1,271 @@
+/**
+ * @file binary_log.h
+ * @brief Binary record format with a sparse time/level index for offline queries
+ *
+ * Defines BinaryFormatter, which encodes each LogRecord as a compact binary
+ * record, BinaryFileSink, which groups those records into blocks and writes
+ * a block index trailer, and BinaryLogReader, which maps a file and finds
+ * the blocks overlapping a time range without touching the others.
+ *
+ * FILE LAYOUT (all integers little-endian):
+ *   File header  (40 bytes): "LLLR", u16 version, u16 reserved, u32 block_size, u32 reserved,
+ *                            f64 ticks_per_ns, u64 anchor_tsc, u64 anchor_unix_ns
+ *   Block        (32 bytes + records): "LLLB", u32 payload_len, u32 record_count,
+ *                            u8 level_mask, 3 reserved, u64 min_tsc, u64 max_tsc
+ *   Record       (32 bytes + location + message): u64 tsc, u64 thread_id, u32 message_len,
+ *                            u32 sample_rate, u8 level, u8 flags, u16 location_len, u32 line,
+ *                            "file\0function" (location_len bytes), message bytes
+ *   Index        (40 bytes per block): u64 file_offset, then the block header fields
+ *                            from payload_len on, u32 reserved
+ *   Footer       (24 bytes): u64 index_offset, u64 block_count, "LLRI", u32 version
+ *
+ * Blocks are self-describing, so a file without a footer (crash, still
+ * being written) is indexed by walking the block headers.
+ *
+ * RESPONSIBILITIES:
+ * - Encode records without text formatting on the consumer thread
+ * - Keep per-block timestamp bounds and a bitmap of the levels present
+ * - Let tools map files, binary-search the index and decode single blocks
+ *
+ * ANTI-RESPONSIBILITIES:
+ * - No compression (see CompressedFileSink)
+ * - No threading (tools parallelize over blocks)
+ */
+
+#ifndef LOGGER_BINARY_LOG_H
+#define LOGGER_BINARY_LOG_H
+
+#include "../internal/cacheline.h"
+#include "config.h"
+#include "formatter.h"
+#include "level.h"
+#include "record.h"
+#include "sink.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace logger {
+
+/**
+ * @brief Encodes LogRecords in the binary record layout (see file comment)
+ *
+ * Pair with BinaryFileSink: the sink expects exactly one encoded record
+ * per Write(), which is how the consumer delivers formatter output.
+ */
+class BinaryFormatter : public Formatter {
+  public:
+    static constexpr std::size_t kRecordHeaderSize = 32;
+    static constexpr unsigned char kFlagHexDump = 0x01; // message is a RecordKind::Binary chunk
+
+    /**
+     * @return Encoded size; if the record does not fit `capacity` the source
+     *         location is dropped first, then the message truncated
+     */
+    std::size_t FormatRecord(const LogRecord &record, char *buffer, std::size_t capacity) override;
+};
+
+/**
+ * @brief Summary of one block, as stored in the index
+ */
+struct BinaryBlockInfo {
+    std::uint64_t file_offset;
+    std::uint32_t payload_len;
+    std::uint32_t record_count;
+    std::uint8_t level_mask; // bit n set if a record of Level n is in the block
+    std::uint64_t min_tsc;
+    std::uint64_t max_tsc;
+};
+
+/**
+ * @brief Block-indexed binary log file
+ *
+ * Write() copies the record into the current block and updates its
+ * timestamp bounds and level bitmap. Full blocks are written as they
+ * close; the index and footer are appended on destruction.
+ */
+class alignas(internal::kCacheLineSize) BinaryFileSink final : public Sink {
+  public:
+    static constexpr std::uint32_t kFileMagic = 0x524C4C4C;  // "LLLR"
+    static constexpr std::uint32_t kBlockMagic = 0x424C4C4C; // "LLLB"
+    static constexpr std::uint32_t kIndexMagic = 0x49524C4C; // "LLRI"
+    static constexpr std::uint16_t kVersion = 1;
+    static constexpr std::size_t kFileHeaderSize = 40;
+    static constexpr std::size_t kBlockHeaderSize = 32;
+    static constexpr std::size_t kIndexEntrySize = 40;
+    static constexpr std::size_t kFooterSize = 24;
+
+    /**
+     * @param path Output file (truncated)
+     * @param block_size Payload bytes per block, i.e. the index granularity
+     */
+    explicit BinaryFileSink(const char *path, std::size_t block_size = LOGGER_BINARY_BLOCK_SIZE) noexcept;
+
+    /**
+     * @brief Writes the partial block, then the index and footer
+     */
+    ~BinaryFileSink() override;
+
+    void Write(const char *data, std::size_t len) override;
+
+    /**
+     * @brief Close the current block and flush the file
+     *
+     * Each flush ends a block, so frequent flushes make the index denser;
+     * pair with a batched consumer flush policy.
+     */
+    void Flush() override;
+
+  private:
+    void CloseBlock();
+    void WriteBlock(const char *payload);
+    void WriteIndex();
+
+    std::FILE *file_;
+    std::size_t block_size_;
+    std::unique_ptr<char[]> block_;
+    BinaryBlockInfo current_;
+    std::uint64_t file_offset_;
+    std::vector<BinaryBlockInfo> index_;
+};
+
+/**
+ * @brief One decoded record; pointers reference the mapped file
+ */
+struct BinaryRecordView {
+    std::uint64_t timestamp; // TSC
+    std::uint64_t thread_id;
+    std::uint32_t sample_rate;
+    std::int32_t line;
+    Level level;
+    const char *file;     // empty string if the record carried no location
+    const char *function; // empty string if the record carried no location
+    const char *message;  // not null-terminated
+    std::size_t message_length;
+    bool hex_dump; // message is a binary payload chunk (render with FormatBinaryChunk)
+};
+
+/**
+ * @brief Read-only, memory-mapped view of a file written by BinaryFileSink
+ *
+ * All methods are const and safe to call from several threads at once
+ * after Open() returns.
+ */
+class BinaryLogReader {
+  public:
+    BinaryLogReader() noexcept = default;
+    ~BinaryLogReader();
+
+    BinaryLogReader(const BinaryLogReader &) = delete;
+    BinaryLogReader &operator=(const BinaryLogReader &) = delete;
+
+    /**
+     * @brief Map a file and load (or rebuild) its block index
+     * @return false if the file is missing or not a binary log
+     */
+    bool Open(const char *path);
+
+    std::size_t BlockCount() const noexcept {
+        return blocks_.size();
+    }
+
+    const BinaryBlockInfo &Block(std::size_t block) const noexcept {
+        return blocks_[block];
+    }
+
+    /**
+     * @brief true if the index came from the footer (false: rebuilt by scanning)
+     */
+    bool HasFooterIndex() const noexcept {
+        return footer_index_;
+    }
+
+    /**
+     * @brief TSC ticks per nanosecond recorded by the writing process
+     *
+     * tsc / TicksPerNanosecond() is the value text logs print as their
+     * timestamp, so it orders binary and text files on one timeline.
+     */
+    double TicksPerNanosecond() const noexcept {
+        return ticks_per_ns_;
+    }
+
+    /**
+     * @brief Convert a record timestamp to nanoseconds since the Unix epoch
+     */
+    std::uint64_t TscToUnixNs(std::uint64_t tsc) const noexcept;
+
+    /**
+     * @brief Inverse of TscToUnixNs (for turning query bounds into timestamps)
+     */
+    std::uint64_t UnixNsToTsc(std::uint64_t unix_ns) const noexcept;
+
+    /**
+     * @brief Range of blocks that may hold records with from_tsc <= tsc <= to_tsc
+     *
+     * Two binary searches over the running max/min of the block bounds, so
+     * the result is exact for ordered files and still complete when records
+     * of different loggers interleave slightly out of order.
+     *
+     * @param[out] first First candidate block
+     * @param[out] last One past the last candidate block (== first if none)
+     */
+    void FindBlocks(std::uint64_t from_tsc, std::uint64_t to_tsc, std::size_t &first,
+                    std::size_t &last) const noexcept;
+
+    /**
+     * @brief Call `fn(const BinaryRecordView &)` for every record of a block
+     * @return false if the block is corrupt (records before the damage are still visited)
+     */
+    template <typename Fn>
+    bool ForEachRecord(std::size_t block, Fn &&fn) const {
+        const BinaryBlockInfo &info = blocks_[block];
+        const unsigned char *p = data_ + info.file_offset + BinaryFileSink::kBlockHeaderSize;
+        const unsigned char *end = p + info.payload_len;
+        BinaryRecordView record;
+        while (p < end) {
+            const std::size_t consumed = ParseRecord(p, static_cast<std::size_t>(end - p), record);
+            if (consumed == 0) {
+                return false;
+            }
+            fn(record);
+            p += consumed;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Text line for a record: UTC time, level, thread, location, message
+     * @return Bytes written (line is newline-terminated, truncated to capacity)
+     */
+    std::size_t FormatText(const BinaryRecordView &record, char *buffer, std::size_t capacity) const noexcept;
+
+    /**
+     * @brief Decode one record
+     * @return Bytes consumed, or 0 if the record is truncated or malformed
+     */
+    static std::size_t ParseRecord(const unsigned char *p, std::size_t available, BinaryRecordView &record) noexcept;
+
+  private:
+    bool LoadFooterIndex();
+    bool ScanBlocks();
+
+    const unsigned char *data_ = nullptr;
+    std::size_t size_ = 0;
+    std::vector<unsigned char> fallback_; // file contents when mmap is unavailable
+    bool mapped_ = false;
+    bool footer_index_ = false;
+    double ticks_per_ns_ = 1.0;
+    std::uint64_t anchor_tsc_ = 0;
+    std::uint64_t anchor_unix_ns_ = 0;
+    std::vector<BinaryBlockInfo> blocks_;
+    std::vector<std::uint64_t> max_prefix_; // running max of max_tsc
+    std::vector<std::uint64_t> min_suffix_; // running min of min_tsc, from the end
+};
+
+} // namespace logger
+
+#endif // LOGGER_BINARY_LOG_H
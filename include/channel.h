@@ -0,0 +1,418 @@
+/**
+ * @file channel.h
+ * @brief One logger's ring, as seen by whichever thread drains it
+ *
+ * Defines Channel, the consumer-side view of a Logger: its ring buffer,
+ * its Router (formatters and sinks) and its FlushController. A Consumer
+ * drains a single channel on a dedicated thread; a Backend drains many
+ * channels on one or more shared shard threads.
+ *
+ * RESPONSIBILITIES:
+ * - Pop records from the ring and hand them to the Router
+ * - Apply the FlushPolicy of whichever output the records go to
+ * - Append ordering-index entries when the output has an index
+ * - Report backlog so a Backend can schedule channels fairly
+ * - Harvest attached histograms into summary records once per interval
+ * - Cache the producer's LogContext text and attach it to the records that use it
+ * - Reassemble messages that span several ring slots
+ * - Report records the producer dropped on a full ring (stderr diagnostics)
+ *
+ * ANTI-RESPONSIBILITIES:
+ * - No threading (the draining thread is owned by Consumer or Backend)
+ * - No producer-side logic (Logger's job)
+ */
+
+#ifndef LOGGER_CHANNEL_H
+#define LOGGER_CHANNEL_H
+
+#include "../internal/clock.h"
+#include "../internal/platform.h"
+#include "../internal/ring_buffer.h"
+#include "config.h"
+#include "flush_policy.h"
+#include "formatter.h"
+#include "histogram.h"
+#include "record.h"
+#include "router.h"
+#include "sink.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace logger {
+
+/**
+ * @brief One entry of a shard's ordering index (host byte order, 24 bytes)
+ *
+ * Written per record when a Backend shard has an index sink, so tools can
+ * merge shard files back into global timestamp order.
+ */
+struct IndexEntry {
+    std::uint64_t timestamp; // record TSC
+    std::uint32_t shard;     // shard whose output holds the record
+    std::uint32_t lane;      // channel (logger) slot in the backend
+    std::uint64_t offset;    // byte offset of the record in the shard output
+};
+
+static_assert(sizeof(IndexEntry) == 24, "IndexEntry is an on-disk format");
+
+/**
+ * @brief Running index of one shard output
+ */
+struct ShardIndex {
+    Sink *sink = nullptr;
+    std::uint64_t offset = 0; // bytes delivered by the shard router so far
+    std::uint32_t shard = 0;
+
+    void Append(std::uint64_t timestamp, std::uint32_t lane, std::size_t bytes) {
+        const IndexEntry entry{timestamp, shard, lane, offset};
+        sink->Write(reinterpret_cast<const char *>(&entry), sizeof(entry));
+        offset += bytes;
+    }
+};
+
+/**
+ * @brief Where drained records go: formatters/sinks, flush policy, optional index
+ *
+ * Either a channel's own output or the shared output of a Backend shard.
+ */
+struct ChannelOutput {
+    Router *router = nullptr;
+    FlushController *flush = nullptr;
+    ShardIndex *index = nullptr;
+
+    /**
+     * @brief Flush every sink (and the index) unconditionally
+     */
+    void FlushSinks() {
+        router->Flush();
+        if (index) {
+            index->sink->Flush();
+        }
+        flush->OnFlushed();
+    }
+
+    /**
+     * @brief Nothing left to drain: flush if the policy says so
+     */
+    void OnIdle() {
+        if (flush->OnIdle()) {
+            FlushSinks();
+        }
+    }
+};
+
+/**
+ * @brief Consumer-side state of one logger
+ *
+ * Drained by exactly one thread at a time (SPSC consumer side).
+ */
+class Channel {
+  public:
+    virtual ~Channel() = default;
+
+    // Non-copyable, Non-movable
+    Channel(const Channel &) = delete;
+    Channel &operator=(const Channel &) = delete;
+    Channel(Channel &&) = delete;
+    Channel &operator=(Channel &&) = delete;
+
+    /**
+     * @brief Approximate number of records waiting in the ring
+     */
+    virtual std::size_t Backlog() const noexcept = 0;
+
+    /**
+     * @brief Pop, format and write up to `budget` records
+     * @param scratch Formatting buffer
+     * @param capacity Size of the formatting buffer
+     * @param budget Maximum number of records to process
+     * @param output Destination of the records (OwnOutput() or a shard output)
+     * @return Number of records processed
+     */
+    virtual std::size_t Drain(char *scratch, std::size_t capacity, std::size_t budget, ChannelOutput &output) = 0;
+
+    /**
+     * @brief The channel's own formatters/sinks and flush policy
+     */
+    ChannelOutput &OwnOutput() noexcept {
+        return own_output_;
+    }
+
+    /**
+     * @brief true if the channel has no sinks of its own and writes to its Backend shard's output
+     */
+    bool SharesOutput() const noexcept {
+        return own_router_.DestinationCount() == 0;
+    }
+
+    /**
+     * @brief The ring ran empty: flush the own output if the policy says so
+     */
+    void OnIdle() {
+        own_output_.OnIdle();
+    }
+
+    /**
+     * @brief Flush the own output unconditionally
+     */
+    void FlushSinks() {
+        own_output_.FlushSinks();
+    }
+
+    /**
+     * @brief Harvest `registry` into summary records every `interval_ns`
+     *
+     * Set before the channel is drained (Logger::AttachHistograms).
+     */
+    void SetHistograms(HistogramRegistry *registry, std::uint64_t interval_ns) noexcept {
+        histograms_ = registry;
+        histogram_interval_ticks_ = registry ? internal::NanosecondsToTsc(interval_ns) : 0;
+        next_harvest_tsc_ = internal::ReadTsc() + histogram_interval_ticks_;
+    }
+
+    /**
+     * @brief true if attached histograms are due for a harvest
+     */
+    LOGGER_FORCE_INLINE bool HistogramsDue() const noexcept {
+        return histograms_ != nullptr && internal::ReadTsc() >= next_harvest_tsc_;
+    }
+
+    /**
+     * @brief Write one summary record per non-empty histogram if an interval has passed
+     * @param final Harvest now, including the current interval (producers have stopped)
+     * @return Number of summary records written
+     */
+    std::size_t PollHistograms(char *scratch, std::size_t capacity, ChannelOutput &output, bool final = false) {
+        if (LOGGER_LIKELY(!histograms_) || (!final && internal::ReadTsc() < next_harvest_tsc_)) {
+            return 0;
+        }
+        next_harvest_tsc_ = internal::ReadTsc() + histogram_interval_ticks_;
+        return histograms_->Harvest([&](const LogRecord &record) { Deliver(record, scratch, capacity, output); },
+                                    final);
+    }
+
+    /**
+     * @brief Logger name ("" for an unnamed logger)
+     */
+    const char *Name() const noexcept {
+        return name_;
+    }
+
+    /**
+     * @brief Producer only: count a record dropped on a full ring
+     *
+     * A plain load and store: the producer is the only writer.
+     */
+    void CountDrop() noexcept {
+        dropped_.value.store(dropped_.value.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Records dropped on a full ring so far (any thread)
+     */
+    std::uint64_t Dropped() const noexcept {
+        return dropped_.value.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Backend slot of this channel (0 when not registered)
+     */
+    std::uint32_t Lane() const noexcept {
+        return lane_;
+    }
+
+  protected:
+    Channel(const char *name, Formatter &formatter, Sink &sink, const FlushPolicy &flush_policy) noexcept
+        : own_router_(formatter, sink), own_flush_(flush_policy) {
+        Init(name);
+    }
+
+    Channel(const char *name, const Destination *destinations, std::size_t count,
+            const FlushPolicy &flush_policy) noexcept
+        : own_router_(destinations, count), own_flush_(flush_policy) {
+        Init(name);
+    }
+
+    LOGGER_FORCE_INLINE void Deliver(const LogRecord &record, char *scratch, std::size_t capacity,
+                                     ChannelOutput &output) {
+        const std::size_t bytes = output.router->Dispatch(record, scratch, capacity);
+        if (LOGGER_UNLIKELY(output.index != nullptr)) {
+            output.index->Append(record.timestamp, lane_, bytes);
+        }
+        if (output.flush->OnWrite(bytes, record.level)) {
+            output.FlushSinks();
+        }
+    }
+
+    /**
+     * @brief Consume a RecordKind::Context record, or attach the cached context to any other record
+     * @return false if the record was a context update (nothing to deliver)
+     */
+    LOGGER_FORCE_INLINE bool ResolveContext(LogRecord &record) noexcept {
+#if LOGGER_ENABLE_CONTEXT
+        if (LOGGER_UNLIKELY(record.kind == RecordKind::Context)) {
+            // The producer has one context version in flight at a time: keep the latest.
+            context_id_ = record.context_id;
+            context_length_ = static_cast<std::uint32_t>(record.message_length);
+            std::memcpy(context_, record.message, record.message_length);
+            return false;
+        }
+        const bool known = record.context_id != 0 && record.context_id == context_id_;
+        record.context = known ? context_ : nullptr;
+        record.context_length = known ? context_length_ : 0;
+#else
+        (void)record;
+#endif
+        return true;
+    }
+
+    /**
+     * @brief Join a spanning record's continuation slots into the channel's reassembly buffer
+     *
+     * The producer publishes a record together with its continuations, so
+     * they are all in the ring when the first one is popped. Sets
+     * record.external_text and record.message_length to the whole text.
+     *
+     * @param pop Pops the next record of the ring into its argument, false if empty
+     * @return Number of continuation slots consumed
+     */
+    template <typename Pop>
+    LOGGER_NO_INLINE std::size_t Reassemble(LogRecord &record, Pop &&pop) noexcept {
+        std::size_t length = std::min(record.message_length, sizeof(spanned_));
+        std::memcpy(spanned_, record.message, length);
+        LogRecord part;
+        std::size_t consumed = 0;
+        while (consumed < record.continuations && pop(part)) {
+            ++consumed;
+            const std::size_t bytes = std::min(part.message_length, sizeof(spanned_) - length);
+            std::memcpy(spanned_ + length, part.message, bytes);
+            length += bytes;
+        }
+        record.external_text = spanned_;
+        record.message_length = length;
+        record.continuations = 0;
+        return consumed;
+    }
+
+    /**
+     * @brief Write the drop count to stderr if it grew, at most once per thousand drops after the first
+     *
+     * Called by the draining thread at the end of a Drain.
+     */
+    LOGGER_FORCE_INLINE void PollDrops() noexcept {
+        if (LOGGER_UNLIKELY(dropped_.value.load(std::memory_order_relaxed) != reported_drops_)) {
+            ReportDrops();
+        }
+    }
+
+  private:
+    friend class Backend;
+
+    LOGGER_NO_INLINE LOGGER_COLD void ReportDrops() noexcept {
+        const std::uint64_t dropped = dropped_.value.load(std::memory_order_relaxed);
+        // Only the first drop and every 1000th drop, to avoid spam
+        const bool report = reported_drops_ == 0 || dropped / 1000 != reported_drops_ / 1000;
+        reported_drops_ = dropped;
+#if LOGGER_ENABLE_STDERR_DIAGNOSTICS
+        if (report) {
+            std::fprintf(stderr, "[LOGGER] Warning: Log buffer full%s%s, dropped %llu log(s)\n", name_[0] ? " in " : "",
+                         name_, static_cast<unsigned long long>(dropped));
+        }
+#else
+        (void)report;
+#endif
+    }
+
+    void Init(const char *name) noexcept {
+        own_output_.router = &own_router_;
+        own_output_.flush = &own_flush_;
+        name_[0] = '\0';
+        if (name) {
+            // Truncate silently; names are labels, not keys.
+            std::strncpy(name_, name, sizeof(name_) - 1);
+            name_[sizeof(name_) - 1] = '\0';
+        }
+    }
+
+    Router own_router_;
+    FlushController own_flush_;
+    ChannelOutput own_output_;
+    HistogramRegistry *histograms_ = nullptr;
+    std::uint64_t histogram_interval_ticks_ = 0;
+    std::uint64_t next_harvest_tsc_ = 0;
+    std::uint32_t lane_ = 0;
+    char name_[LOGGER_MAX_LOGGER_NAME];
+#if LOGGER_ENABLE_CONTEXT
+    std::uint64_t context_id_ = 0;
+    std::uint32_t context_length_ = 0;
+    char context_[LOGGER_MAX_MESSAGE_SIZE];
+#endif
+    char spanned_[kMaxSpannedMessageSize]; // text of the spanning record being delivered
+    std::uint64_t reported_drops_ = 0; // drain side: dropped_ at the last ReportDrops
+
+    // Written by the producer on the drop path only; its own line keeps the
+    // drain-side members above out of that write's reach.
+    struct alignas(internal::kCacheLineSize) DropCounter {
+        std::atomic<std::uint64_t> value{0};
+    };
+    DropCounter dropped_;
+};
+
+/**
+ * @brief Channel over a Logger's SpscRingBuffer
+ *
+ * @tparam Capacity Size of the ring buffer
+ */
+template <std::size_t Capacity>
+class RingChannel final : public Channel {
+  public:
+    RingChannel(internal::SpscRingBuffer<LogRecord, Capacity> &ring_buffer, const char *name, Formatter &formatter,
+                Sink &sink, const FlushPolicy &flush_policy) noexcept
+        : Channel(name, formatter, sink, flush_policy), ring_buffer_(ring_buffer) {}
+
+    /**
+     * @brief Fan-out channel; with no destinations it writes to its Backend shard's output
+     */
+    RingChannel(internal::SpscRingBuffer<LogRecord, Capacity> &ring_buffer, const char *name,
+                const Destination *destinations, std::size_t count, const FlushPolicy &flush_policy) noexcept
+        : Channel(name, destinations, count, flush_policy), ring_buffer_(ring_buffer) {}
+
+    std::size_t Backlog() const noexcept override {
+        return ring_buffer_.Size();
+    }
+
+    std::size_t Drain(char *scratch, std::size_t capacity, std::size_t budget, ChannelOutput &output) override {
+        LogRecord record;
+        std::size_t processed = 0;
+        while (processed < budget && ring_buffer_.TryPop(record)) {
+            if constexpr (LOGGER_CONSUMER_PREFETCH_SLOTS > 0) {
+                // The next slots are already in flight from earlier pops; start the one after them.
+                ring_buffer_.PrefetchAhead(LOGGER_CONSUMER_PREFETCH_SLOTS - 1);
+            }
+            if (LOGGER_LIKELY(record.kind != RecordKind::Literal)) {
+                record.external_text = nullptr; // only a literal's pointer is ever dereferenced
+            }
+            if (LOGGER_UNLIKELY(record.continuations != 0)) {
+                processed += Reassemble(record, [this](LogRecord &part) { return ring_buffer_.TryPop(part); });
+            }
+            if (ResolveContext(record)) {
+                Deliver(record, scratch, capacity, output);
+            }
+            ++processed;
+        }
+        PollDrops();
+        return processed;
+    }
+
+  private:
+    internal::SpscRingBuffer<LogRecord, Capacity> &ring_buffer_;
+};
+
+} // namespace logger
+
+#endif // LOGGER_CHANNEL_H
@@ -0,0 +1,211 @@
+/**
+ * @file compressed_sink.h
+ * @brief File sink that stores output as independently decodable compressed blocks
+ *
+ * Defines CompressedFileSink, which batches formatted output into fixed-size
+ * blocks and compresses them on a helper thread, and CompressedFileReader,
+ * which uses the block index trailer to seek to and decode any block.
+ *
+ * FILE LAYOUT (all integers little-endian):
+ *   File header  (16 bytes): "LLLZ", u16 version, u16 reserved, u32 block_size, u32 reserved
+ *   Block        (12 bytes + data): u32 raw_len, u32 stored_len, u8 codec, 3 reserved, data
+ *   Index        (24 bytes per block): u64 file_offset, u64 raw_offset, u32 raw_len, u32 stored_len
+ *   Footer       (24 bytes): u64 index_offset, u64 block_count, "LLZI", u32 version
+ *
+ * RESPONSIBILITIES:
+ * - Batch writes into preallocated blocks on the consumer thread
+ * - Compress and write blocks on a helper thread (consumer never compresses)
+ * - Emit a block index trailer on close so tools can seek by block
+ *
+ * ANTI-RESPONSIBILITIES:
+ * - No formatting (formatter's job)
+ * - No producer-side work (sink runs on the consumer thread only)
+ */
+
+#ifndef LOGGER_COMPRESSED_SINK_H
+#define LOGGER_COMPRESSED_SINK_H
+
+#include "../internal/block_codec.h"
+#include "../internal/cacheline.h"
+#include "../internal/ring_buffer.h"
+#include "sink.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace logger {
+
+/**
+ * @brief Tuning knobs for CompressedFileSink
+ */
+struct CompressedSinkOptions {
+    std::size_t block_size = 256 * 1024;                    // Raw bytes per block
+    std::size_t block_count = 4;                            // Preallocated blocks in flight (max 16)
+    internal::BlockCodec codec = internal::BlockCodec::Lz4; // Zstd falls back to Lz4 if unavailable
+    int zstd_level = 3;                                     // Used only with BlockCodec::Zstd
+};
+
+/**
+ * @brief Running totals published by the compression thread
+ */
+struct CompressionStats {
+    std::uint64_t raw_bytes;      // Bytes handed to the sink
+    std::uint64_t stored_bytes;   // Bytes written for block payloads
+    std::uint64_t blocks;         // Blocks written
+    std::uint64_t compress_ns;    // Time spent compressing on the helper thread
+    std::uint64_t consumer_waits; // Times the consumer waited for a free block
+};
+
+/**
+ * @brief Compressed, block-indexed file sink
+ *
+ * Write() only copies into the current block. Full blocks (and partial
+ * blocks on Flush) are handed to a helper thread that compresses and writes
+ * them. The consumer waits only when every block is still in flight.
+ */
+class alignas(internal::kCacheLineSize) CompressedFileSink final : public Sink {
+  public:
+    static constexpr std::uint32_t kFileMagic = 0x5A4C4C4C;  // "LLLZ"
+    static constexpr std::uint32_t kIndexMagic = 0x495A4C4C; // "LLZI"
+    static constexpr std::uint16_t kVersion = 1;
+    static constexpr std::size_t kFileHeaderSize = 16;
+    static constexpr std::size_t kBlockHeaderSize = 12;
+    static constexpr std::size_t kIndexEntrySize = 24;
+    static constexpr std::size_t kFooterSize = 24;
+    static constexpr std::size_t kMaxBlocksInFlight = 16;
+
+    explicit CompressedFileSink(const char *path, const CompressedSinkOptions &options = CompressedSinkOptions{}) noexcept;
+
+    /**
+     * @brief Writes any partial block, stops the helper and appends the index
+     */
+    ~CompressedFileSink() override;
+
+    void Write(const char *data, std::size_t len) override;
+
+    /**
+     * @brief Hand the partial block to the helper thread (non-blocking)
+     *
+     * Each flush closes a block, so frequent flushes shrink blocks and hurt
+     * the compression ratio; pair with a batched consumer flush policy.
+     */
+    void Flush() override;
+
+    /**
+     * @brief Snapshot of compression totals (safe from any thread)
+     */
+    CompressionStats Stats() const noexcept;
+
+  private:
+    struct Block {
+        char *data;
+        std::size_t size;
+    };
+
+    struct IndexEntry {
+        std::uint64_t file_offset;
+        std::uint64_t raw_offset;
+        std::uint32_t raw_len;
+        std::uint32_t stored_len;
+    };
+
+    void Submit();
+    void AcquireBlock();
+    void CompressLoop();
+    void WriteBlock(const Block &block);
+    void WriteIndex();
+
+    std::FILE *file_;
+    CompressedSinkOptions options_;
+    std::unique_ptr<char[]> block_storage_;
+    std::unique_ptr<char[]> compressed_;
+    std::size_t compressed_capacity_;
+    std::unique_ptr<std::uint32_t[]> hash_table_;
+    Block blocks_[kMaxBlocksInFlight];
+
+    // Consumer-owned: block currently being filled (-1 if none).
+    int current_;
+
+    // Block handoff: consumer -> helper (filled) and helper -> consumer (free).
+    internal::SpscRingBuffer<std::uint32_t, 32> filled_;
+    internal::SpscRingBuffer<std::uint32_t, 32> free_;
+
+    // Helper-owned index and stream position.
+    std::vector<IndexEntry> index_;
+    std::uint64_t file_offset_;
+    std::uint64_t raw_offset_;
+    bool index_valid_ = true; // false once a failed write left file_offset_ unknown
+
+    std::atomic<std::uint64_t> raw_bytes_{0};
+    std::atomic<std::uint64_t> stored_bytes_{0};
+    std::atomic<std::uint64_t> blocks_written_{0};
+    std::atomic<std::uint64_t> compress_ns_{0};
+    std::atomic<std::uint64_t> consumer_waits_{0};
+
+    std::atomic<bool> stopping_{false};
+    std::thread helper_;
+};
+
+/**
+ * @brief Random-access reader for files written by CompressedFileSink
+ */
+class CompressedFileReader {
+  public:
+    CompressedFileReader() noexcept = default;
+    ~CompressedFileReader();
+
+    CompressedFileReader(const CompressedFileReader &) = delete;
+    CompressedFileReader &operator=(const CompressedFileReader &) = delete;
+
+    /**
+     * @brief Open a file and load its block index
+     * @return false if the file is missing, truncated or not a compressed log
+     */
+    bool Open(const char *path);
+
+    std::size_t BlockCount() const noexcept {
+        return index_.size();
+    }
+
+    std::size_t BlockSize() const noexcept {
+        return block_size_;
+    }
+
+    /**
+     * @brief Uncompressed offset of the first byte of a block
+     */
+    std::uint64_t BlockRawOffset(std::size_t block) const noexcept {
+        return block < index_.size() ? index_[block].raw_offset : 0;
+    }
+
+    /**
+     * @brief Decode one block
+     * @param block Block number
+     * @param buffer Destination (at least BlockSize() bytes)
+     * @param capacity Size of the destination
+     * @return Decoded size, or 0 on error
+     */
+    std::size_t ReadBlock(std::size_t block, char *buffer, std::size_t capacity);
+
+  private:
+    struct IndexEntry {
+        std::uint64_t file_offset;
+        std::uint64_t raw_offset;
+        std::uint32_t raw_len;
+        std::uint32_t stored_len;
+    };
+
+    std::FILE *file_ = nullptr;
+    std::size_t block_size_ = 0;
+    std::vector<IndexEntry> index_;
+    std::vector<char> stored_;
+};
+
+} // namespace logger
+
+#endif // LOGGER_COMPRESSED_SINK_H
@@ -23,6 +23,31 @@
 #define LOGGER_MAX_MESSAGE_SIZE 1024
 #endif
 
+/**
+ * @brief Maximum number of consecutive ring slots one message may span.
+ *
+ * A message longer than LOGGER_MAX_MESSAGE_SIZE - 1 continues in up to
+ * LOGGER_MAX_RECORD_SPAN - 1 extra slots (see LongMessagePolicy), so rare
+ * large messages survive without growing every slot. Each channel keeps a
+ * reassembly buffer of LOGGER_MAX_RECORD_SPAN * LOGGER_MAX_MESSAGE_SIZE bytes.
+ * 1 restores plain truncation.
+ */
+#ifndef LOGGER_MAX_RECORD_SPAN
+#define LOGGER_MAX_RECORD_SPAN 16
+#endif
+
+/**
+ * @brief Lowest level compiled into the LLL_TRACE .. LLL_FATAL macros (0 = Trace .. 5 = Fatal).
+ *
+ * Calls below it are discarded at compile time: their arguments are still
+ * type-checked but no code is generated. Logger::IsEnabled also rejects
+ * them, so direct Log() calls below the floor return LogResult::Filtered.
+ * 6 compiles out every level.
+ */
+#ifndef LOGGER_COMPILE_TIME_MIN_LEVEL
+#define LOGGER_COMPILE_TIME_MIN_LEVEL 0
+#endif
+
 /**
  * @brief Enable thread ID in log records.
  *
@@ -42,6 +67,31 @@
 #define LOGGER_ENABLE_SOURCE_LOCATION 1
 #endif
 
+/**
+ * @brief Enable per-thread logging context (LogContext / LLL_CONTEXT).
+ *
+ * If enabled, every record carries the version id of the calling thread's
+ * context stack; the context text itself is sent to the consumer only when
+ * the version changes.
+ */
+#ifndef LOGGER_ENABLE_CONTEXT
+#define LOGGER_ENABLE_CONTEXT 1
+#endif
+
+/**
+ * @brief Bytes of rendered "key=value key=value" text a thread's context may hold.
+ */
+#ifndef LOGGER_MAX_CONTEXT_SIZE
+#define LOGGER_MAX_CONTEXT_SIZE 256
+#endif
+
+/**
+ * @brief Maximum number of fields on a thread's context stack.
+ */
+#ifndef LOGGER_MAX_CONTEXT_DEPTH
+#define LOGGER_MAX_CONTEXT_DEPTH 8
+#endif
+
 /**
  * @brief Enable dropping info into stdout/stderr.
  *
@@ -51,6 +101,39 @@
 #define LOGGER_ENABLE_STDERR_DIAGNOSTICS 1
 #endif
 
+/**
+ * @brief Maximum number of (Formatter, Sink, Level) destinations per consumer.
+ *
+ * Destinations are stored in fixed arrays inside the Router, so no allocation
+ * is needed when a consumer fans out to several sinks.
+ */
+#ifndef LOGGER_MAX_DESTINATIONS
+#define LOGGER_MAX_DESTINATIONS 8
+#endif
+
+/**
+ * @brief Maximum number of named loggers registered with one Backend.
+ *
+ * The backend keeps its loggers in a fixed array of atomic slots.
+ */
+#ifndef LOGGER_MAX_BACKEND_CHANNELS
+#define LOGGER_MAX_BACKEND_CHANNELS 32
+#endif
+
+/**
+ * @brief Maximum number of consumer (shard) threads per Backend.
+ */
+#ifndef LOGGER_MAX_BACKEND_SHARDS
+#define LOGGER_MAX_BACKEND_SHARDS 16
+#endif
+
+/**
+ * @brief Maximum length of a logger name (including the terminator).
+ */
+#ifndef LOGGER_MAX_LOGGER_NAME
+#define LOGGER_MAX_LOGGER_NAME 32
+#endif
+
 // ============================================================================
 // PERFORMANCE TUNING
 // ============================================================================
@@ -77,4 +160,93 @@
 #define LOGGER_BACKEND_SPIN_COUNT 1000
 #endif
 
+/**
+ * @brief Write records into the ring with non-temporal (cache-bypassing) stores.
+ *
+ * The producer never reads a slot back, so with large rings normal stores
+ * only evict its own working set. When enabled (and supported, see
+ * internal/nontemporal.h) TryPush copies the record with streaming stores
+ * and issues a store fence before publishing it.
+ *
+ * 1: producer caches keep its own data; each push pays a fence
+ * 0: slots are written through the cache (best when the ring fits in L2)
+ */
+#ifndef LOGGER_RING_NONTEMPORAL
+#define LOGGER_RING_NONTEMPORAL 0
+#endif
+
+/**
+ * @brief Ring slots the consumer prefetches ahead of the one it pops.
+ *
+ * While draining, each pop issues LOGGER_PREFETCH_READ for every cache line
+ * of the slot this many positions ahead (if the producer has published it),
+ * so its lines are in flight while the current record is formatted.
+ *
+ * Higher values: more misses hidden, more lines held for later
+ * 0:             no software prefetch (hardware prefetcher only)
+ */
+#ifndef LOGGER_CONSUMER_PREFETCH_SLOTS
+#define LOGGER_CONSUMER_PREFETCH_SLOTS 2
+#endif
+
+/**
+ * @brief Records a consumer drains per pass before re-checking its state.
+ *
+ * A Backend splits this budget across its loggers in proportion to their
+ * backlog (every non-empty logger gets at least one record per pass).
+ *
+ * Higher values: fewer passes, coarser interleaving between loggers
+ * Lower values:  finer fairness, more per-pass overhead
+ */
+#ifndef LOGGER_BACKEND_PASS_BUDGET
+#define LOGGER_BACKEND_PASS_BUDGET 256
+#endif
+
+/**
+ * @brief Backlog (records) a channel must reach before an idle shard may steal from it.
+ *
+ * Only used by a Backend created with work stealing enabled. A stolen batch
+ * is at most LOGGER_BACKEND_PASS_BUDGET records.
+ */
+#ifndef LOGGER_BACKEND_STEAL_MIN_BACKLOG
+#define LOGGER_BACKEND_STEAL_MIN_BACKLOG 512
+#endif
+
+/**
+ * @brief Default interval (ms) between histogram summary records
+ *
+ * See Logger::AttachHistograms. Each interval emits one record per
+ * histogram that received samples.
+ */
+#ifndef LOGGER_HISTOGRAM_INTERVAL_MS
+#define LOGGER_HISTOGRAM_INTERVAL_MS 1000
+#endif
+
+/**
+ * @brief Default payload bytes per block of a BinaryFileSink file
+ *
+ * One index entry (40 bytes) is written per block, so this sets the
+ * granularity of time-range queries: a query decodes at least one block.
+ */
+#ifndef LOGGER_BINARY_BLOCK_SIZE
+#define LOGGER_BINARY_BLOCK_SIZE (64 * 1024)
+#endif
+
+/**
+ * @brief Default batched flush triggers of the consumer (see flush_policy.h).
+ *
+ * The consumer flushes its sinks once this many formatted bytes are
+ * pending, or once the oldest unflushed byte is this many microseconds old.
+ *
+ * Higher values: fewer flush syscalls, more output held in sink buffers
+ * Lower values:  output reaches the OS sooner, more syscalls per record
+ */
+#ifndef LOGGER_FLUSH_MAX_BYTES
+#define LOGGER_FLUSH_MAX_BYTES (256 * 1024)
+#endif
+
+#ifndef LOGGER_FLUSH_MAX_DELAY_US
+#define LOGGER_FLUSH_MAX_DELAY_US 1000
+#endif
+
 #endif // LOGGER_CONFIG_H
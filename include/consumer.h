@@ -3,17 +3,15 @@
  * @brief Background consumer thread for the low-latency logger
  *
  * Defines the Consumer class which runs in a background thread to drain
- * the ring buffer, format format log records, and write them to the sink.
+ * one logger's Channel (ring buffer -> formatters -> sinks).
  *
  * RESPONSIBILITIES:
- * - Drain SpscRingBuffer<LogRecord>
- * - Format records using Formatter
- * - Write output using Sink
+ * - Drain the Channel on a dedicated thread
  * - Manage background thread lifecycle (Start/Stop)
  * - Implement hybrid spin/sleep wait strategy for low latency
  *
  * ANTI-RESPONSIBILITIES:
- * - No ownership of ring buffer (reference only)
+ * - No ownership of the channel or ring buffer (reference only)
  * - No direct file I/O (delegated to Sink)
  * - No formatting logic (delegated to Formatter)
  */
@@ -22,42 +20,34 @@
 #define LOGGER_CONSUMER_H
 
 #include "../internal/platform.h"
-#include "../internal/ring_buffer.h"
+#include "channel.h"
 #include "config.h"
 #include "formatter.h"
-#include "record.h"
-#include "sink.h"
 
 #include <atomic>
 #include <chrono>
-#include <cstddef>
 #include <thread>
-#include <type_traits>
 
 namespace logger {
 
 /**
  * @brief Background log consumer
  *
- * This class wraps the background worker thread that continuously polls
- * the ring buffer for new log records. It uses a hybrid wait strategy:
+ * This class wraps the background worker thread that continuously drains
+ * one logger's Channel. It uses a hybrid wait strategy:
  * 1. Busy spin for LOGGER_BACKEND_SPIN_COUNT iterations (low latency)
  * 2. Sleep for a short duration (to save CPU when idle)
  *
- * @tparam Capacity Size of the ring buffer (must match ring buffer's capacity)
+ * To drain many loggers from one thread, use a Backend instead.
  */
-template <std::size_t Capacity>
 class Consumer {
   public:
     /**
      * @brief Construct a new Consumer
      *
-     * @param ring_buffer Reference to the shared ring buffer
-     * @param formatter Reference to the formatter implementation
-     * @param sink Reference to the sink implementation
+     * @param channel Channel to drain (ring buffer, router and flush policy); must outlive the Consumer
      */
-    Consumer(internal::SpscRingBuffer<LogRecord, Capacity> &ring_buffer, Formatter &formatter, Sink &sink)
-        : ring_buffer_(ring_buffer), formatter_(formatter), sink_(sink), is_running_(false) {}
+    explicit Consumer(Channel &channel) : channel_(channel), is_running_(false) {}
 
     /**
      * @brief Destructor
@@ -127,29 +117,20 @@ class Consumer {
      * @brief Main loop for the consumer thread
      */
     void Loop() {
-        // Local buffer for formatting messages.
-        // Size = LOGGER_MAX_MESSAGE_SIZE + overhead for:
-        //   - Timestamp (~30 bytes)
-        //   - Level string (~10 bytes)
-        //   - Thread ID (~20 bytes)
-        //   - Source location file/line/function (~150 bytes)
-        //   - Brackets, spaces, newline (~46 bytes)
-        // Total overhead: ~256 bytes
-        static constexpr std::size_t kFormattingOverhead = 256;
-        static constexpr std::size_t kScratchBufferSize = LOGGER_MAX_MESSAGE_SIZE + kFormattingOverhead;
-        char scratch_buffer[kScratchBufferSize];
-        LogRecord record;
+        char scratch_buffer[kFormatScratchSize];
 
         while (is_running_.load(std::memory_order_relaxed)) {
-            // fast path: consume available items
-            if (ring_buffer_.TryPop(record)) {
-                std::size_t len = formatter_.FormatRecord(record, scratch_buffer, sizeof(scratch_buffer));
-                sink_.Write(scratch_buffer, len);
+            // fast path: consume available items (bounded so the stop signal stays responsive)
+            const std::size_t drained =
+                channel_.Drain(scratch_buffer, sizeof(scratch_buffer), LOGGER_BACKEND_PASS_BUDGET, channel_.OwnOutput());
+            // Periodic histogram summaries, as in Backend::RunPass (a null check unless attached)
+            channel_.PollHistograms(scratch_buffer, sizeof(scratch_buffer), channel_.OwnOutput());
+            if (drained > 0) {
                 continue; // Immediately check for more
             }
 
-            // empty path: flush and wait
-            sink_.Flush();
+            // empty path: flush if the policy says so, then wait
+            channel_.OnIdle();
 
             // Hybrid Wait Strategy:
             // 1. Spin-wait for recent activity (low latency)
@@ -160,23 +141,14 @@ class Consumer {
                 if (!is_running_.load(std::memory_order_relaxed)) {
                     goto shutdown;
                 }
-                /*
-                    if this try pop is successful then it also deletes that data from ring buffer and that data is now only available
-                    in record here  which is local to this thread and loop as well from line 146.
-
-
-                    so we have to write same logic as starting of loop in if(found_activity) block.
-                */
-                if (ring_buffer_.TryPop(record)) {
+                // Only peek here; the next loop iteration drains.
+                if (channel_.Backlog() > 0) {
                     found_activity = true;
                     break;
                 }
             }
 
-            if (found_activity) {
-                std::size_t len = formatter_.FormatRecord(record, scratch_buffer, sizeof(scratch_buffer));
-                sink_.Write(scratch_buffer, len);
-            } else {
+            if (!found_activity) {
                 // 2. Sleep to save CPU if no activity for a while
                 // Check runs flag one last time before sleeping
                 if (is_running_.load(std::memory_order_relaxed)) {
@@ -187,12 +159,10 @@ class Consumer {
 
     shutdown:
         // Ensure everything is flushed before exit
-        sink_.Flush();
+        channel_.FlushSinks();
     }
 
-    internal::SpscRingBuffer<LogRecord, Capacity> &ring_buffer_;
-    Formatter &formatter_;
-    Sink &sink_;
+    Channel &channel_;
 
     std::atomic<bool> is_running_;
     std::thread thread_;
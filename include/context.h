@@ -0,0 +1,184 @@
+/**
+ * @file context.h
+ * @brief Per-thread logging context (MDC): scoped key=value fields
+ *
+ * Defines LogContext, a thread-local stack of fields such as the order id
+ * and venue of the order being processed, and ScopedContext / LLL_CONTEXT
+ * to push a field for the rest of a scope. Every push and pop assigns the
+ * stack a new process-wide version id.
+ *
+ * A log call stores only the current version id in its record. The logger
+ * sends the rendered stack to the consumer once per version (a
+ * RecordKind::Context record), and the consumer's Channel attaches its cached
+ * copy to the records that follow, where the formatters print it.
+ *
+ * RESPONSIBILITIES:
+ * - Keep the fields of the calling thread, rendered as "key=value key=value"
+ * - Version the stack so unchanged contexts are never re-sent
+ *
+ * ANTI-RESPONSIBILITIES:
+ * - No synchronization (each thread owns its stack)
+ * - No shipping to the consumer (Logger's job) or rendering of records (Formatter's job)
+ */
+
+#ifndef LOGGER_CONTEXT_H
+#define LOGGER_CONTEXT_H
+
+#include "../internal/platform.h"
+#include "config.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace logger {
+
+/**
+ * @brief The calling thread's context stack
+ */
+class LogContext {
+  public:
+    /**
+     * @brief The calling thread's context (constant-initialized thread_local, no guard)
+     */
+    LOGGER_FORCE_INLINE static LogContext &Current() noexcept {
+        static LOGGER_THREAD_LOCAL LogContext context;
+        return context;
+    }
+
+    /**
+     * @brief Append "key=value"
+     * @return false (and no change) if the stack is full or the text does not fit
+     */
+    bool Push(const char *key, const char *value) noexcept {
+        return Push(key, value, value ? std::strlen(value) : 0);
+    }
+
+    /**
+     * @brief Append "key=<decimal value>"
+     */
+    bool Push(const char *key, std::int64_t value) noexcept {
+        char digits[21];
+        std::size_t n = sizeof(digits);
+        std::uint64_t magnitude = value < 0 ? 0 - static_cast<std::uint64_t>(value) : static_cast<std::uint64_t>(value);
+        do {
+            digits[--n] = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude != 0);
+        if (value < 0) {
+            digits[--n] = '-';
+        }
+        return Push(key, digits + n, sizeof(digits) - n);
+    }
+
+    /**
+     * @brief Remove the most recently pushed field
+     */
+    void Pop() noexcept {
+        if (depth_ == 0) {
+            return;
+        }
+        --depth_;
+        length_ = depth_ == 0 ? 0 : ends_[depth_ - 1];
+        version_ = depth_ == 0 ? 0 : NextVersion();
+    }
+
+    /**
+     * @brief Id of the current contents; 0 when the stack is empty
+     */
+    std::uint64_t Version() const noexcept {
+        return version_;
+    }
+
+    const char *Text() const noexcept {
+        return text_;
+    }
+
+    std::size_t Length() const noexcept {
+        return length_;
+    }
+
+    std::size_t Depth() const noexcept {
+        return depth_;
+    }
+
+  private:
+    constexpr LogContext() noexcept = default;
+
+    bool Push(const char *key, const char *value, std::size_t value_length) noexcept {
+        const std::size_t key_length = key ? std::strlen(key) : 0;
+        const std::size_t separator = depth_ == 0 ? 0 : 1;
+        if (depth_ == LOGGER_MAX_CONTEXT_DEPTH ||
+            length_ + separator + key_length + 1 + value_length > LOGGER_MAX_CONTEXT_SIZE) {
+            return false;
+        }
+        char *out = text_ + length_;
+        if (separator) {
+            *out++ = ' ';
+        }
+        std::memcpy(out, key, key_length);
+        out += key_length;
+        *out++ = '=';
+        std::memcpy(out, value, value_length);
+        length_ = static_cast<std::size_t>(out + value_length - text_);
+        ends_[depth_++] = static_cast<std::uint16_t>(length_);
+        version_ = NextVersion();
+        return true;
+    }
+
+    static std::uint64_t NextVersion() noexcept {
+        static std::atomic<std::uint64_t> next{1};
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static_assert(LOGGER_MAX_CONTEXT_SIZE <= 0xFFFF, "context offsets are 16-bit");
+
+    std::uint64_t version_ = 0;
+    std::size_t length_ = 0;
+    std::size_t depth_ = 0;
+    std::uint16_t ends_[LOGGER_MAX_CONTEXT_DEPTH] = {};
+    char text_[LOGGER_MAX_CONTEXT_SIZE] = {};
+};
+
+/**
+ * @brief Pushes a field onto the calling thread's context for the lifetime of the object
+ */
+class ScopedContext {
+  public:
+    ScopedContext(const char *key, const char *value) noexcept : pushed_(LogContext::Current().Push(key, value)) {}
+
+    template <typename Integer, typename = std::enable_if_t<std::is_integral_v<Integer>>>
+    ScopedContext(const char *key, Integer value) noexcept
+        : pushed_(LogContext::Current().Push(key, static_cast<std::int64_t>(value))) {}
+
+    ~ScopedContext() {
+        if (pushed_) {
+            LogContext::Current().Pop();
+        }
+    }
+
+    ScopedContext(const ScopedContext &) = delete;
+    ScopedContext &operator=(const ScopedContext &) = delete;
+
+  private:
+    bool pushed_;
+};
+
+} // namespace logger
+
+#define LLL_CONTEXT_JOIN_(a, b) a##b
+#define LLL_CONTEXT_NAME_(prefix, line) LLL_CONTEXT_JOIN_(prefix, line)
+
+/**
+ * @brief Add `key=value` to every record this thread logs until the end of the scope
+ *
+ * Example:
+ *   LLL_CONTEXT("order", order.id);
+ *   LLL_CONTEXT("venue", order.venue);
+ *   log.Info("accepted"); // -> "... [order=1234 venue=XNAS] accepted"
+ */
+#define LLL_CONTEXT(key, value) ::logger::ScopedContext LLL_CONTEXT_NAME_(lll_context_, __LINE__)((key), (value))
+
+#endif // LOGGER_CONTEXT_H
@@ -17,7 +17,9 @@ enum class ErrorCode : std::uint8_t {
     None = 0,
     FileOpenFailed,
     WriteFailed,
-    FlushFailed
+    FlushFailed,
+    InvalidConfig,
+    SyncFailed
 };
 
 /**
@@ -33,6 +35,10 @@ inline const char *ErrorToString(ErrorCode code) noexcept {
         return "WRITE_FAILED";
     case ErrorCode::FlushFailed:
         return "FLUSH_FAILED";
+    case ErrorCode::InvalidConfig:
+        return "INVALID_CONFIG";
+    case ErrorCode::SyncFailed:
+        return "SYNC_FAILED";
     }
     return "UNKNOWN";
 }
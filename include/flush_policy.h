@@ -0,0 +1,146 @@
+/**
+ * @file flush_policy.h
+ * @brief When the consumer flushes its sinks
+ *
+ * Defines FlushPolicy (the user-facing knobs) and FlushController (the
+ * consumer-side bookkeeping that turns writes and idle polls into flush
+ * decisions).
+ *
+ * RESPONSIBILITIES:
+ * - Track bytes written since the last flush and the age of the oldest one
+ * - Decide when to flush: eagerly, by size, by age, or on Error records
+ *
+ * ANTI-RESPONSIBILITIES:
+ * - No I/O (the caller flushes the Router)
+ * - No threading (owned by a single consumer thread)
+ */
+
+#ifndef LOGGER_FLUSH_POLICY_H
+#define LOGGER_FLUSH_POLICY_H
+
+#include "../internal/platform.h"
+#include "config.h"
+#include "level.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace logger {
+
+/**
+ * @brief Consumer flush triggers
+ *
+ * Batched (default): flush when max_bytes are pending, when the oldest
+ * pending byte is max_delay_us old, or after an Error/Fatal record.
+ * Eager: flush every time the ring runs empty (one flush per burst, which
+ * at moderate rates means one flush per record).
+ * Shutdown always flushes.
+ */
+struct FlushPolicy {
+    enum class Mode : std::uint8_t {
+        Eager,
+        Batched,
+    };
+
+    Mode mode = Mode::Batched;
+    std::size_t max_bytes = LOGGER_FLUSH_MAX_BYTES;       // 0 disables the size trigger
+    std::uint32_t max_delay_us = LOGGER_FLUSH_MAX_DELAY_US; // 0 disables the age trigger
+    bool flush_on_error = true;
+
+    static FlushPolicy Eager() noexcept {
+        FlushPolicy policy;
+        policy.mode = Mode::Eager;
+        return policy;
+    }
+};
+
+/**
+ * @brief Per-consumer flush bookkeeping
+ *
+ * The consumer reports every dispatched record with OnWrite() and every
+ * empty poll with OnIdle(); either returns true when the sinks should be
+ * flushed now, after which the consumer calls OnFlushed().
+ */
+class FlushController {
+  public:
+    explicit FlushController(const FlushPolicy &policy = FlushPolicy{}) noexcept : policy_(policy) {}
+
+    /**
+     * @brief Account for a dispatched record
+     * @param bytes Bytes the record produced across all sinks
+     * @param level Level of the record
+     * @return true if the sinks should be flushed now
+     */
+    LOGGER_FORCE_INLINE bool OnWrite(std::size_t bytes, Level level) noexcept {
+        if (bytes == 0) {
+            return false;
+        }
+        if (pending_bytes_ == 0) {
+            oldest_ = Clock::now();
+        }
+        pending_bytes_ += bytes;
+        if (LOGGER_UNLIKELY(policy_.flush_on_error && ShouldLog(level, Level::Error))) {
+            return true;
+        }
+        if (policy_.mode == FlushPolicy::Mode::Eager) {
+            return false;
+        }
+        if (policy_.max_bytes != 0 && pending_bytes_ >= policy_.max_bytes) {
+            return true;
+        }
+        // A busy ring never runs empty: check the age every few records too.
+        return (++writes_since_check_ & (kAgeCheckInterval - 1)) == 0 && AgeExpired();
+    }
+
+    /**
+     * @brief Account for an empty poll
+     * @return true if pending output should be flushed now
+     */
+    bool OnIdle() noexcept {
+        if (pending_bytes_ == 0) {
+            return false;
+        }
+        return policy_.mode == FlushPolicy::Mode::Eager || AgeExpired();
+    }
+
+    /**
+     * @brief Reset after the caller flushed the sinks
+     */
+    void OnFlushed() noexcept {
+        pending_bytes_ = 0;
+        writes_since_check_ = 0;
+    }
+
+    /**
+     * @brief Bytes written since the last flush
+     */
+    std::size_t PendingBytes() const noexcept {
+        return pending_bytes_;
+    }
+
+    const FlushPolicy &Policy() const noexcept {
+        return policy_;
+    }
+
+  private:
+    using Clock = std::chrono::steady_clock;
+    static constexpr std::uint32_t kAgeCheckInterval = 64; // power of two
+
+    bool AgeExpired() const noexcept {
+        // Age trigger disabled: pending output waits for the size trigger or shutdown.
+        if (policy_.max_delay_us == 0) {
+            return false;
+        }
+        return Clock::now() - oldest_ >= std::chrono::microseconds(policy_.max_delay_us);
+    }
+
+    FlushPolicy policy_;
+    std::size_t pending_bytes_ = 0;
+    std::uint32_t writes_since_check_ = 0;
+    Clock::time_point oldest_{};
+};
+
+} // namespace logger
+
+#endif // LOGGER_FLUSH_POLICY_H
@@ -18,12 +18,91 @@
 #ifndef LOGGER_FORMATTER_H
 #define LOGGER_FORMATTER_H
 
+#include "config.h"
+#include "level.h"
 #include "record.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 
 namespace logger {
 
+/**
+ * @brief Bytes of one hex dump line: "  00000000: 4865 6c6c ... 0a00  Hello world.....\n"
+ */
+inline constexpr std::size_t kHexDumpLineSize = 70;
+
+/**
+ * @brief Size of the consumer-side formatting buffer
+ *
+ * Room for the larger of a full message rendered as a hex dump (about 4.4
+ * bytes per payload byte) and a message spanning LOGGER_MAX_RECORD_SPAN
+ * slots behind its "[context] " prefix, plus overhead for:
+ *   - Timestamp (~30 bytes)
+ *   - Level string (~10 bytes)
+ *   - Thread ID (~20 bytes)
+ *   - Source location file/line/function (~150 bytes)
+ *   - Brackets, spaces, newline (~46 bytes)
+ */
+inline constexpr std::size_t kFormatScratchSize =
+    std::max<std::size_t>((LOGGER_MAX_MESSAGE_SIZE / 16 + 1) * kHexDumpLineSize,
+                          kMaxSpannedMessageSize + LOGGER_MAX_CONTEXT_SIZE + 3) +
+    256;
+
+/**
+ * @brief Everything the text layout prints, with the timestamp already in nanoseconds
+ *
+ * Lets offline decoders (which convert timestamps with the calibration
+ * stored in a file) produce exactly the lines TextFormatter produces live.
+ */
+struct TextLineFields {
+    std::uint64_t timestamp_ns;
+    Level level;
+    std::uint32_t sample_rate; // printed when > 1
+    bool has_thread_id;
+    std::uint64_t thread_id;
+    const char *file;     // location printed when file and function are non-null
+    const char *function;
+    std::int32_t line;
+    const char *message;
+    std::size_t message_length;
+    bool hex_dump; // message is a RecordKind::Binary chunk, printed as a hex dump
+};
+
+/**
+ * @brief Write one text line: "[ns] [LEVEL] [sample=1/N] [tid=T] file:line function message\n"
+ * @return Bytes written; the line is truncated to capacity - 1 and null-terminated
+ */
+std::size_t FormatTextLine(const TextLineFields &fields, char *buffer, std::size_t capacity) noexcept;
+
+/**
+ * @brief Render a RecordKind::Binary chunk as hex/ASCII lines
+ *
+ * The first chunk of a payload starts with "<label> (<size> bytes)\n";
+ * later chunks are only dump lines, with offsets continuing where the
+ * previous chunk stopped, so consecutive chunks read as one dump.
+ *
+ * @return Bytes written (whole lines only), null-terminated
+ */
+std::size_t FormatBinaryChunk(const char *chunk, std::size_t length, char *buffer, std::size_t capacity) noexcept;
+
+/**
+ * @brief Payload text of a record, whatever its kind
+ *
+ * RecordKind::Message and RecordKind::Literal return record.MessageData()
+ * (for a literal, the literal itself). RecordKind::ScopeTimer
+ * renders "<name> took <ns> ns" into `scratch`, converting the TSC delta with
+ * this process's calibration. A record with an attached context is prefixed with
+ * "[key=value ...] ". RecordKind::Binary returns the raw chunk (see
+ * FormatBinaryChunk) without context.
+ *
+ * @param scratch Buffer of at least kFormatScratchSize bytes (used for scope timers)
+ * @param[out] length Payload length in bytes
+ * @return record.MessageData() or scratch
+ */
+const char *RecordPayload(const LogRecord &record, char *scratch, std::size_t &length) noexcept;
+
 /**
  * @brief Formats LogRecord objects into text
  *
@@ -0,0 +1,319 @@
+/**
+ * @file histogram.h
+ * @brief Producer-side latency histograms, harvested into periodic summary records
+ *
+ * For values recorded millions of times per second (per-message latencies),
+ * one record per sample is too much. A Histogram is keyed by callsite; each
+ * producer thread records into its own log-linear HistogramCell with plain
+ * (relaxed, single-writer) stores, and the draining thread of the logger the
+ * registry is attached to harvests all cells once per interval and writes one
+ * summary record (count, min, percentiles, max, mean) per histogram.
+ *
+ * Each cell is double-buffered: producers write the active buffer, and the
+ * harvest flips the active index and reads the buffer that was retired one
+ * interval earlier, so a producer that read the index just before a flip has
+ * a whole interval to finish its update. A summary therefore reports the
+ * interval before the latest one.
+ *
+ * RESPONSIBILITIES:
+ * - Log-linear bucketing (16 sub-buckets per power of two, ~6% resolution)
+ * - Per-thread, per-callsite cells with no atomic read-modify-write on record
+ * - Lock-free registration of callsites and cells
+ * - Building summary LogRecords from harvested histograms
+ *
+ * ANTI-RESPONSIBILITIES:
+ * - No timing of its own (the Channel decides when to harvest)
+ * - No I/O (summary records go through the logger's formatters and sinks)
+ * - No reclamation: a cell lives for the process, like its callsite
+ */
+
+#ifndef LOGGER_HISTOGRAM_H
+#define LOGGER_HISTOGRAM_H
+
+#include "../internal/cacheline.h"
+#include "../internal/platform.h"
+#include "level.h"
+#include "record.h"
+#include "source_location.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(LOGGER_COMPILER_MSVC)
+#include <intrin.h>
+#endif
+
+namespace logger {
+
+namespace internal {
+
+/**
+ * @brief Index of the highest set bit (value must be non-zero)
+ */
+LOGGER_FORCE_INLINE unsigned HighestBit(std::uint64_t value) noexcept {
+#if defined(LOGGER_COMPILER_GCC_COMPATIBLE)
+    return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#elif defined(LOGGER_COMPILER_MSVC) && defined(LOGGER_ARCH_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return static_cast<unsigned>(index);
+#else
+    unsigned index = 0;
+    while (value >>= 1) {
+        ++index;
+    }
+    return index;
+#endif
+}
+
+} // namespace internal
+
+/**
+ * @brief Plain log-linear histogram of 64-bit values (snapshot / merge target)
+ *
+ * Values below 16 have exact buckets; above that every power of two is
+ * split into 16 equal sub-buckets, so a bucket spans at most 1/16 of its
+ * lower bound.
+ */
+class LogLinearHistogram {
+  public:
+    static constexpr unsigned kSubBucketBits = 4;
+    static constexpr std::size_t kSubBuckets = std::size_t{1} << kSubBucketBits;
+    static constexpr std::size_t kBucketCount = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+    LogLinearHistogram() noexcept {
+        Reset();
+    }
+
+    LOGGER_FORCE_INLINE static std::size_t BucketOf(std::uint64_t value) noexcept {
+        if (value < kSubBuckets) {
+            return static_cast<std::size_t>(value);
+        }
+        const unsigned exponent = internal::HighestBit(value);
+        const unsigned shift = exponent - kSubBucketBits;
+        return (shift + 1) * kSubBuckets + static_cast<std::size_t>((value >> shift) & (kSubBuckets - 1));
+    }
+
+    /**
+     * @brief Smallest value that lands in `bucket`
+     */
+    static std::uint64_t BucketLow(std::size_t bucket) noexcept;
+
+    /**
+     * @brief Largest value that lands in `bucket`
+     */
+    static std::uint64_t BucketHigh(std::size_t bucket) noexcept;
+
+    void Record(std::uint64_t value, std::uint64_t times = 1) noexcept;
+    void Merge(const LogLinearHistogram &other) noexcept;
+    void Reset() noexcept;
+
+    /**
+     * @brief Value at quantile q in [0, 1]: the midpoint of its bucket, clamped to [Min, Max]
+     * @return 0 for an empty histogram
+     */
+    std::uint64_t Percentile(double q) const noexcept;
+
+    std::uint64_t Count() const noexcept {
+        return count_;
+    }
+    std::uint64_t Sum() const noexcept {
+        return sum_;
+    }
+    std::uint64_t Min() const noexcept {
+        return count_ ? min_ : 0;
+    }
+    std::uint64_t Max() const noexcept {
+        return max_;
+    }
+    std::uint64_t BucketTotal(std::size_t bucket) const noexcept {
+        return counts_[bucket];
+    }
+
+  private:
+    friend class HistogramCell;
+
+    std::uint64_t counts_[kBucketCount];
+    std::uint64_t count_;
+    std::uint64_t sum_;
+    std::uint64_t min_;
+    std::uint64_t max_;
+};
+
+/**
+ * @brief One thread's histogram for one callsite, double-buffered
+ *
+ * Record() is called only by the owning thread; Harvest() only by the
+ * harvesting thread. Every field is an atomic accessed with relaxed
+ * load/store pairs, so neither side needs a read-modify-write.
+ */
+class alignas(internal::kCacheLineSize) HistogramCell {
+  public:
+    HistogramCell() noexcept {
+        buffers_[0].Reset();
+        buffers_[1].Reset();
+    }
+
+    HistogramCell(const HistogramCell &) = delete;
+    HistogramCell &operator=(const HistogramCell &) = delete;
+
+    LOGGER_FORCE_INLINE void Record(std::uint64_t value) noexcept {
+        Buffer &buffer = buffers_[active_.load(std::memory_order_acquire)];
+        Bump(buffer.counts[LogLinearHistogram::BucketOf(value)], 1);
+        Bump(buffer.count, 1);
+        Bump(buffer.sum, value);
+        if (value < buffer.min.load(std::memory_order_relaxed)) {
+            buffer.min.store(value, std::memory_order_relaxed);
+        }
+        if (value > buffer.max.load(std::memory_order_relaxed)) {
+            buffer.max.store(value, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Add the buffer retired by the previous call to `into`, then retire the active one
+     * @param final Also take the active buffer (producers must have stopped recording)
+     */
+    void Harvest(LogLinearHistogram &into, bool final = false) noexcept;
+
+  private:
+    friend class Histogram;
+
+    struct Buffer {
+        std::atomic<std::uint64_t> counts[LogLinearHistogram::kBucketCount];
+        std::atomic<std::uint64_t> count;
+        std::atomic<std::uint64_t> sum;
+        std::atomic<std::uint64_t> min;
+        std::atomic<std::uint64_t> max;
+
+        void Reset() noexcept;
+        void DrainInto(LogLinearHistogram &into) noexcept;
+    };
+
+    LOGGER_FORCE_INLINE static void Bump(std::atomic<std::uint64_t> &field, std::uint64_t delta) noexcept {
+        field.store(field.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+    std::atomic<std::uint32_t> active_{0};
+    Buffer buffers_[2];
+    HistogramCell *next_ = nullptr; // Histogram's cell list
+};
+
+class HistogramRegistry;
+
+/**
+ * @brief A named histogram (usually one per callsite, see LLL_HISTOGRAM_RECORD)
+ *
+ * Registers itself with a registry on construction; both must live until
+ * the logger the registry is attached to has stopped (function-local
+ * statics do).
+ */
+class Histogram {
+  public:
+    Histogram(HistogramRegistry &registry, const char *name, Level level = Level::Info, const char *file = nullptr,
+              int line = 0, const char *function = nullptr) noexcept;
+
+    Histogram(const Histogram &) = delete;
+    Histogram &operator=(const Histogram &) = delete;
+
+    /**
+     * @brief Allocate a cell for the calling thread (keep it in a thread_local)
+     * @return nullptr if allocation failed
+     */
+    HistogramCell *NewCell() noexcept;
+
+    /**
+     * @brief Harvest every thread's cell into `into`
+     */
+    void Harvest(LogLinearHistogram &into, bool final = false) noexcept;
+
+    /**
+     * @brief Fill `record` with this histogram's summary of `data`
+     *
+     * Message: "<name> n=N min=A p50=B p90=C p99=D p999=E max=F mean=G".
+     */
+    void Summarize(const LogLinearHistogram &data, LogRecord &record) const noexcept;
+
+    const char *Name() const noexcept {
+        return name_;
+    }
+
+  private:
+    friend class HistogramRegistry;
+
+    const char *name_;
+    Level level_;
+    int line_;
+    const char *file_;
+    const char *function_;
+    std::atomic<HistogramCell *> cells_{nullptr};
+    Histogram *next_ = nullptr; // registry list
+};
+
+/**
+ * @brief The set of histograms one logger harvests (see Logger::AttachHistograms)
+ */
+class HistogramRegistry {
+  public:
+    HistogramRegistry() = default;
+    HistogramRegistry(const HistogramRegistry &) = delete;
+    HistogramRegistry &operator=(const HistogramRegistry &) = delete;
+
+    /**
+     * @brief Add a histogram (lock-free, any thread)
+     */
+    void Add(Histogram &histogram) noexcept;
+
+    /**
+     * @brief Harvest every histogram and pass one summary record per non-empty one to `emit`
+     *
+     * Called by a single harvesting thread.
+     *
+     * @param final Also take samples of the current interval (producers must have stopped)
+     * @return Number of records emitted
+     */
+    template <typename Emit>
+    std::size_t Harvest(Emit &&emit, bool final = false) {
+        std::size_t emitted = 0;
+        for (Histogram *histogram = head_.load(std::memory_order_acquire); histogram;
+             histogram = histogram->next_) {
+            data_.Reset();
+            histogram->Harvest(data_, final);
+            if (data_.Count() == 0) {
+                continue;
+            }
+            histogram->Summarize(data_, record_);
+            emit(static_cast<const LogRecord &>(record_));
+            ++emitted;
+        }
+        return emitted;
+    }
+
+  private:
+    std::atomic<Histogram *> head_{nullptr};
+    LogLinearHistogram data_; // harvest scratch (harvesting thread only)
+    LogRecord record_;
+};
+
+} // namespace logger
+
+/**
+ * @brief Record `value` into the callsite's histogram, in the calling thread's cell
+ *
+ * The first call on a thread allocates that thread's cell; after that a
+ * call costs a thread-local load, a bucket computation and a few stores.
+ *
+ * Example:
+ *   LLL_HISTOGRAM_RECORD(registry, logger::Level::Info, "order_to_ack_ns", ack_ns);
+ */
+#define LLL_HISTOGRAM_RECORD(registry, level, name, value)                                                         \
+    do {                                                                                                           \
+        static ::logger::Histogram lll_histogram_((registry), (name), (level), LLL_FILE_NAME, __LINE__, __func__); \
+        static LOGGER_THREAD_LOCAL ::logger::HistogramCell *lll_histogram_cell_ = lll_histogram_.NewCell();        \
+        if (LOGGER_LIKELY(lll_histogram_cell_ != nullptr)) {                                                       \
+            lll_histogram_cell_->Record(static_cast<std::uint64_t>(value));                                        \
+        }                                                                                                          \
+    } while (0)
+
+#endif // LOGGER_HISTOGRAM_H
@@ -10,6 +10,8 @@
  * - Capture timestamps, thread IDs, and source locations
  * - Push log records to the ring buffer (non-blocking)
  * - Manage ring buffer, formatter, sink, and consumer lifecycle
+ *   (own Consumer thread, or a channel registered with a shared Backend)
+ * - Filter by a runtime minimum level
  * - Handle backpressure (drop logs when buffer is full)
  *
  * ANTI-RESPONSIBILITIES:
@@ -23,18 +25,28 @@
 
 #include "../internal/platform.h"
 #include "../internal/ring_buffer.h"
+#include "backend.h"
+#include "channel.h"
 #include "config.h"
 #include "consumer.h"
+#include "context.h"
+#include "flush_policy.h"
 #include "formatter.h"
+#include "histogram.h"
 #include "level.h"
 #include "record.h"
+#include "sampler.h"
 #include "sink.h"
+#include "source_location.h"
+#include "static_string.h"
 
+#include <algorithm>
 #include <atomic>
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
 #include <functional>
+#include <string_view>
 #include <thread>
 
 namespace logger {
@@ -45,9 +57,18 @@ namespace logger {
 enum class LogResult {
     Success,    // Log record was successfully enqueued
     BufferFull, // Ring buffer is full, log was dropped
+    Sampled,    // Call was skipped by the sampling policy
+    Filtered,   // Level is below the logger's runtime minimum level
     Error       // Other error (should not happen in normal operation)
 };
 
+/**
+ * @brief Compile-time level floor (LOGGER_COMPILE_TIME_MIN_LEVEL)
+ */
+inline constexpr Level kCompileTimeMinLevel = static_cast<Level>(LOGGER_COMPILE_TIME_MIN_LEVEL);
+static_assert(LOGGER_COMPILE_TIME_MIN_LEVEL >= 0 && LOGGER_COMPILE_TIME_MIN_LEVEL <= 6,
+              "LOGGER_COMPILE_TIME_MIN_LEVEL must be 0 (Trace) .. 6 (off)");
+
 /**
  * @brief Main logger class
  *
@@ -69,14 +90,69 @@ class Logger {
      *
      * @param formatter Reference to the formatter implementation
      * @param sink Reference to the sink implementation
+     * @param flush_policy When the consumer flushes the sink (default: batched)
      *
      * Note: The formatter and sink must outlive the Logger.
      */
-    Logger(Formatter &formatter, Sink &sink) : consumer_(ring_buffer_, formatter, sink) {
+    Logger(Formatter &formatter, Sink &sink, const FlushPolicy &flush_policy = FlushPolicy{})
+        : channel_(ring_buffer_, nullptr, formatter, sink, flush_policy), consumer_(channel_) {
         // Ring buffer is default-constructed (empty)
         // Consumer is constructed but not started
     }
 
+    /**
+     * @brief Construct a Logger that fans out to several destinations
+     *
+     * Each record is formatted once per distinct formatter and written to
+     * every destination whose min_level it meets.
+     *
+     * @param destinations Array of (Formatter, Sink, min Level) destinations (copied)
+     * @param count Number of destinations (at most LOGGER_MAX_DESTINATIONS)
+     * @param flush_policy When the consumer flushes the sinks (default: batched)
+     *
+     * Note: The formatters and sinks must outlive the Logger.
+     */
+    Logger(const Destination *destinations, std::size_t count, const FlushPolicy &flush_policy = FlushPolicy{})
+        : channel_(ring_buffer_, nullptr, destinations, count, flush_policy), consumer_(channel_) {}
+
+    /**
+     * @brief Construct a named Logger drained by a shared Backend
+     *
+     * No thread is created: Start() registers this logger with the backend
+     * and Stop() unregisters it.
+     *
+     * @param backend Backend whose thread drains this logger (must outlive it)
+     * @param name Logger name (truncated to LOGGER_MAX_LOGGER_NAME - 1 chars)
+     * @param formatter Reference to the formatter implementation
+     * @param sink Reference to the sink implementation
+     * @param flush_policy When the backend flushes the sink (default: batched)
+     */
+    Logger(Backend &backend, const char *name, Formatter &formatter, Sink &sink,
+           const FlushPolicy &flush_policy = FlushPolicy{})
+        : channel_(ring_buffer_, name, formatter, sink, flush_policy), consumer_(channel_), backend_(&backend) {}
+
+    /**
+     * @brief Construct a named Logger that writes to its Backend shard's output
+     *
+     * The backend shard thread formats the records with the shard's
+     * formatter and writes them to the shard's sink (see
+     * Backend::SetShardDestination), so K shards give K output streams.
+     *
+     * @param backend Backend whose thread drains this logger (must outlive it)
+     * @param name Logger name (truncated to LOGGER_MAX_LOGGER_NAME - 1 chars)
+     * @param shard Shard to pin this logger to, or -1 to let the backend choose
+     */
+    Logger(Backend &backend, const char *name, int shard = -1)
+        : channel_(ring_buffer_, name, nullptr, 0, FlushPolicy{}), consumer_(channel_), backend_(&backend),
+          shard_(shard) {}
+
+    /**
+     * @brief Construct a named, fan-out Logger drained by a shared Backend
+     */
+    Logger(Backend &backend, const char *name, const Destination *destinations, std::size_t count,
+           const FlushPolicy &flush_policy = FlushPolicy{})
+        : channel_(ring_buffer_, name, destinations, count, flush_policy), consumer_(channel_), backend_(&backend) {}
+
     /**
      * @brief Destructor
      *
@@ -93,31 +169,103 @@ class Logger {
     Logger &operator=(Logger &&) = delete;
 
     /**
-     * @brief Start the background consumer thread
+     * @brief Start the background consumer thread (or register with the backend)
      *
      * This must be called before logging. The consumer thread will
      * continuously drain the ring buffer and write logs to the sink.
      */
     void Start() {
+        if (backend_) {
+            bool expected = false;
+            if (registered_.compare_exchange_strong(expected, true) && !backend_->Register(channel_, shard_)) {
+                registered_.store(false, std::memory_order_relaxed);
+            }
+            return;
+        }
         consumer_.Start();
     }
 
     /**
-     * @brief Stop the background consumer thread
+     * @brief Stop the background consumer thread (or unregister from the backend)
      *
      * Signals the consumer to stop and waits for it to finish.
      * This will flush any remaining logs in the buffer.
      */
     void Stop() {
-        consumer_.Stop();
+        if (backend_) {
+            bool expected = true;
+            if (!registered_.compare_exchange_strong(expected, false)) {
+                return;
+            }
+            // Shard-output channels are drained into the shard output by the backend.
+            backend_->Unregister(channel_);
+            if (channel_.SharesOutput()) {
+                return;
+            }
+        } else {
+            if (!consumer_.IsRunning()) {
+                return;
+            }
+            consumer_.Stop();
+        }
+        // No thread drains the ring any more: drain what is left here.
+        char scratch_buffer[kFormatScratchSize];
+        while (channel_.Drain(scratch_buffer, sizeof(scratch_buffer), LOGGER_BACKEND_PASS_BUDGET, channel_.OwnOutput()) > 0) {
+        }
+        channel_.PollHistograms(scratch_buffer, sizeof(scratch_buffer), channel_.OwnOutput(), true);
+        channel_.FlushSinks();
+    }
+
+    /**
+     * @brief Harvest `registry` on this logger's draining thread, one summary record per histogram per interval
+     *
+     * Call before Start(). Attach a registry to one logger only. Stop()
+     * writes the samples of the last, partial interval too (for a logger
+     * writing to its Backend shard's output, only if the backend stopped first).
+     *
+     * @param registry Histograms to harvest (must outlive the logger's draining)
+     * @param interval_ms Harvest interval
+     */
+    void AttachHistograms(HistogramRegistry &registry,
+                          std::uint64_t interval_ms = LOGGER_HISTOGRAM_INTERVAL_MS) noexcept {
+        channel_.SetHistograms(&registry, interval_ms * 1000000u);
     }
 
     /**
      * @brief Check if the logger is running
-     * @return true if the consumer thread is running
+     * @return true if the consumer thread is running (or registered with the backend)
      */
     bool IsRunning() const {
-        return consumer_.IsRunning();
+        return backend_ ? registered_.load(std::memory_order_relaxed) : consumer_.IsRunning();
+    }
+
+    /**
+     * @brief Logger name (empty for loggers without a backend)
+     */
+    const char *Name() const noexcept {
+        return channel_.Name();
+    }
+
+    /**
+     * @brief Set the runtime minimum level (any thread)
+     *
+     * Calls below it return LogResult::Filtered before any other work.
+     */
+    void SetLevel(Level level) noexcept {
+        min_level_.store(level, std::memory_order_relaxed);
+    }
+
+    Level GetLevel() const noexcept {
+        return min_level_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief true if a call at `level` would pass the compile-time floor and the runtime level filter
+     *
+     * The floor test folds away for a constant `level`.
+     */
+    LOGGER_FORCE_INLINE bool IsEnabled(Level level) const noexcept {
+        return ShouldLog(level, kCompileTimeMinLevel) && ShouldLog(level, min_level_.load(std::memory_order_relaxed));
     }
 
     /**
@@ -154,6 +302,77 @@ class Logger {
 #endif
     }
 
+    /**
+     * @brief Log a string literal without copying it
+     *
+     * Stores only the pointer and length (RecordKind::Literal); the consumer
+     * reads the literal when it formats the record, so the text is never cut
+     * at LOGGER_MAX_MESSAGE_SIZE.
+     *
+     * @param level Log severity level
+     * @param message "text"_lll or LLL_STATIC("text") (static_string.h)
+     * @return LogResult indicating success or failure
+     */
+    LOGGER_FORCE_INLINE LogResult Log(Level level, StaticString message) noexcept {
+        return LogLiteral(level, message, nullptr, 0, nullptr);
+    }
+
+    /**
+     * @brief Log a string literal with source location, without copying it
+     */
+    LOGGER_FORCE_INLINE LogResult Log(Level level, StaticString message, const char *file, int line,
+                                      const char *function) noexcept {
+        return LogLiteral(level, message, file, line, function);
+    }
+
+    /**
+     * @brief Log text of known length (std::string, buffer slices); copied, no strlen
+     *
+     * @param level Log severity level
+     * @param message Text to copy (may contain '\0')
+     * @return LogResult indicating success or failure
+     */
+    LOGGER_FORCE_INLINE LogResult Log(Level level, std::string_view message) noexcept {
+        return Log(level, message, nullptr, 0, nullptr);
+    }
+
+    /**
+     * @brief Log text of known length with source location; copied, no strlen
+     */
+    LOGGER_FORCE_INLINE LogResult Log(Level level, std::string_view message, const char *file, int line,
+                                      const char *function) noexcept {
+        if (!IsEnabled(level)) {
+            return LogResult::Filtered;
+        }
+        return LogCopy(level, message.data(), message.size(), file, line, function);
+    }
+
+    /**
+     * @brief Log a message at a call site captured as one value
+     *
+     * @param level Log severity level
+     * @param message Null-terminated message string
+     * @param where LLL_HERE, or SourceLocation::Current() on C++20
+     * @return LogResult indicating success or failure
+     */
+    LOGGER_FORCE_INLINE LogResult Log(Level level, const char *message, const SourceLocation &where) noexcept {
+        return Log(level, message, where.file, where.line, where.function);
+    }
+
+    /**
+     * @brief Log a string literal at a call site, without copying it
+     */
+    LOGGER_FORCE_INLINE LogResult Log(Level level, StaticString message, const SourceLocation &where) noexcept {
+        return LogLiteral(level, message, where.file, where.line, where.function);
+    }
+
+    /**
+     * @brief Log text of known length at a call site; copied, no strlen
+     */
+    LOGGER_FORCE_INLINE LogResult Log(Level level, std::string_view message, const SourceLocation &where) noexcept {
+        return Log(level, message, where.file, where.line, where.function);
+    }
+
     /**
      * @brief Log a formatted message using printf-style formatting
      *
@@ -164,11 +383,22 @@ class Logger {
      */
     template <typename... Args>
     LOGGER_FORCE_INLINE LogResult LogFormat(Level level, const char *fmt, Args... args) noexcept {
+        if (!IsEnabled(level)) {
+            return LogResult::Filtered;
+        }
+        std::uint32_t sample_rate;
+        if (!sampler_.Admit(level, sample_rate)) {
+            return LogResult::Sampled;
+        }
         LogRecord record;
         if (!PrepareRecord(record, level)) {
             return LogResult::Error;
         }
+        record.sample_rate = sample_rate;
         record.FormatMessage(fmt, args...);
+        if (LOGGER_UNLIKELY(Overflows(record))) {
+            return PushFormatted(record, fmt, args...);
+        }
         return PushRecord(record);
     }
 
@@ -186,10 +416,76 @@ class Logger {
     template <typename... Args>
     LOGGER_FORCE_INLINE LogResult LogFormat(Level level, const char *file, int line, const char *function,
                                             const char *fmt, Args... args) noexcept {
+        if (!IsEnabled(level)) {
+            return LogResult::Filtered;
+        }
+        std::uint32_t sample_rate;
+        if (!sampler_.Admit(level, sample_rate)) {
+            return LogResult::Sampled;
+        }
+        LogRecord record;
+        if (!PrepareRecord(record, level)) {
+            return LogResult::Error;
+        }
+        record.sample_rate = sample_rate;
+#if LOGGER_ENABLE_SOURCE_LOCATION
+        record.SetSourceLocation(file, line, function);
+#else
+        (void)file;
+        (void)line;
+        (void)function;
+#endif
+        record.FormatMessage(fmt, args...);
+        if (LOGGER_UNLIKELY(Overflows(record))) {
+            return PushFormatted(record, fmt, args...);
+        }
+        return PushRecord(record);
+    }
+
+    /**
+     * @brief Log a formatted message at a call site captured as one value
+     *
+     * @param level Log severity level
+     * @param where LLL_HERE, or SourceLocation::Current() on C++20
+     * @param fmt Format string
+     * @param args Format arguments
+     * @return LogResult indicating success or failure
+     */
+    template <typename... Args>
+    LOGGER_FORCE_INLINE LogResult LogFormat(Level level, const SourceLocation &where, const char *fmt,
+                                            Args... args) noexcept {
+        return LogFormat(level, where.file, where.line, where.function, fmt, args...);
+    }
+
+    /**
+     * @brief Log a formatted message through a per-callsite sampler
+     *
+     * The callsite policy replaces the per-level policy for this call.
+     * Usually invoked through LLL_LOG_SAMPLED (sampler.h).
+     *
+     * @param point Callsite sampling state
+     * @param level Log severity level
+     * @param file Source file name
+     * @param line Line number
+     * @param function Function name
+     * @param fmt Format string
+     * @param args Format arguments
+     * @return LogResult::Sampled if the call was skipped
+     */
+    template <typename... Args>
+    LOGGER_FORCE_INLINE LogResult LogSampled(SamplePoint &point, Level level, const char *file, int line,
+                                             const char *function, const char *fmt, Args... args) noexcept {
+        if (!IsEnabled(level)) {
+            return LogResult::Filtered;
+        }
+        if (!point.Admit()) {
+            return LogResult::Sampled;
+        }
         LogRecord record;
         if (!PrepareRecord(record, level)) {
             return LogResult::Error;
         }
+        record.sample_rate = point.Rate();
 #if LOGGER_ENABLE_SOURCE_LOCATION
         record.SetSourceLocation(file, line, function);
 #else
@@ -198,9 +494,145 @@ class Logger {
         (void)function;
 #endif
         record.FormatMessage(fmt, args...);
+        if (LOGGER_UNLIKELY(Overflows(record))) {
+            return PushFormatted(record, fmt, args...);
+        }
+        return PushRecord(record);
+    }
+
+    /**
+     * @brief Log the duration of a scope measured by the caller
+     *
+     * Pushes both TSC readings and the scope name; the consumer converts
+     * end_tsc - start_tsc to nanoseconds when it formats the record, so the
+     * producer does no arithmetic beyond the copy. Not subject to sampling.
+     * Usually invoked through ScopedTimer / LLL_SCOPE_TIMER (scoped_timer.h).
+     *
+     * @param level Log severity level
+     * @param name Scope name (copied into the record)
+     * @param name_length Length of `name` in bytes
+     * @param start_tsc ReadTsc() at scope entry (becomes the record timestamp)
+     * @param end_tsc ReadTsc() at scope exit
+     * @param file Source file name (nullptr for none)
+     * @param line Line number
+     * @param function Function name (nullptr for none)
+     * @return LogResult indicating success or failure
+     */
+    LOGGER_FORCE_INLINE LogResult LogScopeTimer(Level level, const char *name, std::size_t name_length,
+                                                std::uint64_t start_tsc, std::uint64_t end_tsc,
+                                                const char *file = nullptr, int line = 0,
+                                                const char *function = nullptr) noexcept {
+        if (!IsEnabled(level)) {
+            return LogResult::Filtered;
+        }
+        LogRecord record;
+        if (!PrepareRecord(record, level, start_tsc)) {
+            return LogResult::Error;
+        }
+        record.kind = RecordKind::ScopeTimer;
+        record.end_timestamp = end_tsc;
+        record.SetMessage(name, name_length);
+#if LOGGER_ENABLE_SOURCE_LOCATION
+        if (file && function) {
+            record.SetSourceLocation(file, line, function);
+        }
+#else
+        (void)file;
+        (void)line;
+        (void)function;
+#endif
         return PushRecord(record);
     }
 
+    /**
+     * @brief Log a raw byte payload (packet, buffer) without formatting it
+     *
+     * The bytes are copied into the record as-is; the consumer renders a
+     * hex/ASCII dump. Payloads larger than one record are split into
+     * consecutive records that the consumer prints as one continuous dump.
+     * All chunks are published together or none (BufferFull). Not subject
+     * to sampling.
+     *
+     * @param level Log severity level
+     * @param data Payload bytes
+     * @param size Payload size in bytes (< 4 GiB)
+     * @param label Printed before the dump (cut at kMaxBinaryLabel bytes; nullptr for none)
+     * @param file Source file name (nullptr for none)
+     * @param line Line number
+     * @param function Function name (nullptr for none)
+     * @return LogResult indicating success or failure
+     */
+    LogResult LogBinary(Level level, const void *data, std::size_t size, const char *label = nullptr,
+                        const char *file = nullptr, int line = 0, const char *function = nullptr) noexcept {
+        if (!IsEnabled(level)) {
+            return LogResult::Filtered;
+        }
+        if (LOGGER_UNLIKELY((!data && size != 0) || size > 0xFFFFFFFFu)) {
+            return LogResult::Error;
+        }
+        std::size_t label_length = 0;
+        while (label && label_length < kMaxBinaryLabel && label[label_length] != '\0') {
+            ++label_length;
+        }
+        const std::size_t chunk_capacity = LogRecord::BinaryChunkCapacity(label_length);
+        const std::size_t chunks = size == 0 ? 1 : (size + chunk_capacity - 1) / chunk_capacity;
+
+        LogRecord record;
+        if (!PrepareRecord(record, level)) {
+            return LogResult::Error;
+        }
+        record.kind = RecordKind::Binary;
+#if LOGGER_ENABLE_SOURCE_LOCATION
+        if (file && function) {
+            record.SetSourceLocation(file, line, function);
+        }
+#else
+        (void)file;
+        (void)line;
+        (void)function;
+#endif
+        // Staged like PushSpanned: one release store publishes every chunk.
+        if (ring_buffer_.FreeSlots() < chunks) {
+            return DropRecord();
+        }
+        const unsigned char *bytes = static_cast<const unsigned char *>(data);
+        std::size_t offset = 0;
+        for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+            const std::size_t length = std::min(chunk_capacity, size - offset);
+            record.SetBinaryChunk(label, label_length, bytes + offset, length, static_cast<std::uint32_t>(offset),
+                                  static_cast<std::uint32_t>(size));
+            ring_buffer_.StageAt(chunk, record);
+            offset += length;
+        }
+        ring_buffer_.PublishStaged(chunks);
+        return LogResult::Success;
+    }
+
+    /**
+     * @brief Configure sampling for every call at the given level
+     *
+     * Must be called before logging starts or from the producer thread.
+     *
+     * @param level Level to configure
+     * @param mode Sampling mode (None disables sampling)
+     * @param rate Keep 1 in `rate` calls
+     */
+    void SetSampling(Level level, SamplingMode mode, std::uint32_t rate) noexcept {
+        sampler_.Set(level, mode, rate);
+    }
+
+    /**
+     * @brief Choose between truncating and spanning messages longer than one record
+     *
+     * Span (the default when LOGGER_MAX_RECORD_SPAN > 1) pushes the message
+     * and its continuation slots together, or nothing (BufferFull); text past
+     * kMaxSpannedMessageSize is cut. Must be called before logging starts or
+     * from the producer thread.
+     */
+    void SetLongMessagePolicy(LongMessagePolicy policy) noexcept {
+        long_messages_ = LOGGER_MAX_RECORD_SPAN > 1 ? policy : LongMessagePolicy::Truncate;
+    }
+
     // Convenience methods for each log level
 
     LOGGER_FORCE_INLINE LogResult Trace(const char *message) noexcept {
@@ -227,6 +659,32 @@ class Logger {
         return Log(Level::Fatal, message);
     }
 
+    // Convenience methods for literals (no copy)
+
+    LOGGER_FORCE_INLINE LogResult Trace(StaticString message) noexcept {
+        return Log(Level::Trace, message);
+    }
+
+    LOGGER_FORCE_INLINE LogResult Debug(StaticString message) noexcept {
+        return Log(Level::Debug, message);
+    }
+
+    LOGGER_FORCE_INLINE LogResult Info(StaticString message) noexcept {
+        return Log(Level::Info, message);
+    }
+
+    LOGGER_FORCE_INLINE LogResult Warn(StaticString message) noexcept {
+        return Log(Level::Warn, message);
+    }
+
+    LOGGER_FORCE_INLINE LogResult Error(StaticString message) noexcept {
+        return Log(Level::Error, message);
+    }
+
+    LOGGER_FORCE_INLINE LogResult Fatal(StaticString message) noexcept {
+        return Log(Level::Fatal, message);
+    }
+
     // Convenience methods with source location
 
     LOGGER_FORCE_INLINE LogResult Trace(const char *message, const char *file, int line,
@@ -267,6 +725,13 @@ class Logger {
         return ring_buffer_.Size();
     }
 
+    /**
+     * @brief Records dropped because the ring was full, since construction (any thread)
+     */
+    std::uint64_t DroppedCount() const noexcept {
+        return channel_.Dropped();
+    }
+
     /**
      * @brief Check if the ring buffer is full
      * @return true if buffer is full
@@ -278,25 +743,80 @@ class Logger {
   private:
     /**
      * @brief Internal implementation of Log()
-        Basically what LogImpl() does is it checks if the message is not null, prepares the record, sets the message, sets the source location (if enabled), and pushes the record to the ring buffer.
+        Basically what LogImpl() does is it checks if the message is not null and the level is enabled, then measures the message and hands it to LogCopy().
      */
     LOGGER_FORCE_INLINE LogResult LogImpl(Level level, const char *message, const char *file, int line,
                                           const char *function) noexcept {
         if (LOGGER_UNLIKELY(!message)) {
             return LogResult::Error;
         }
+        if (!IsEnabled(level)) {
+            return LogResult::Filtered;
+        }
+        return LogCopy(level, message, std::strlen(message), file, line, function);
+    }
+
+    /**
+     * @brief Copy `length` bytes of text into a record and push it (level already checked)
+     */
+    LOGGER_FORCE_INLINE LogResult LogCopy(Level level, const char *message, std::size_t length, const char *file,
+                                          int line, const char *function) noexcept {
+        std::uint32_t sample_rate;
+        if (!sampler_.Admit(level, sample_rate)) {
+            return LogResult::Sampled;
+        }
 
         LogRecord record;
         if (!PrepareRecord(record, level)) {
             return LogResult::Error;
         }
+        record.sample_rate = sample_rate;
 
-        record.SetMessage(message);
+        record.SetMessage(message, length);
+
+#if LOGGER_ENABLE_SOURCE_LOCATION
+        if (file && function) {
+            record.SetSourceLocation(file, line, function);
+        }
+#else
+        (void)file;
+        (void)line;
+        (void)function;
+#endif
+        if (LOGGER_UNLIKELY(Overflows(record))) {
+            return PushSpanned(record, message, length);
+        }
+        return PushRecord(record);
+    }
 
+    /**
+     * @brief Push a record that points to a literal instead of holding text
+     */
+    LOGGER_FORCE_INLINE LogResult LogLiteral(Level level, StaticString message, const char *file, int line,
+                                             const char *function) noexcept {
+        if (!IsEnabled(level)) {
+            return LogResult::Filtered;
+        }
+        std::uint32_t sample_rate;
+        if (!sampler_.Admit(level, sample_rate)) {
+            return LogResult::Sampled;
+        }
+        LogRecord record;
+        if (!PrepareRecord(record, level)) {
+            return LogResult::Error;
+        }
+        record.sample_rate = sample_rate;
+        record.kind = RecordKind::Literal;
+        record.external_text = message.data(); // a pointer store instead of strlen + memcpy
+        record.message_length = message.size();
 #if LOGGER_ENABLE_SOURCE_LOCATION
         if (file && function) {
             record.SetSourceLocation(file, line, function);
         }
+#else
+        (void)file;
+        (void)line;
+        (void)function;
 #endif
         return PushRecord(record);
     }
@@ -308,10 +828,28 @@ class Logger {
      * @return true on success, false on error
      */
     LOGGER_FORCE_INLINE bool PrepareRecord(LogRecord &record, Level level) noexcept {
+        return PrepareRecord(record, level, internal::ReadTsc()); // TSC for lowest latency
+    }
+
+    /**
+     * @brief PrepareRecord() with a timestamp the caller already captured
+     */
+    LOGGER_FORCE_INLINE bool PrepareRecord(LogRecord &record, Level level, std::uint64_t timestamp) noexcept {
         record.level = level;
+        record.kind = RecordKind::Message;
+        record.continuations = 0;
+        record.sample_rate = 1;
+        record.timestamp = timestamp;
+        record.end_timestamp = 0;
 
-        // Capture timestamp (using TSC for lowest latency)
-        record.timestamp = internal::ReadTsc();
+#if LOGGER_ENABLE_CONTEXT
+        // One TLS load and a store; the context text travels only when it changed.
+        const LogContext &context = LogContext::Current();
+        record.context_id = context.Version();
+        if (LOGGER_UNLIKELY(record.context_id != shipped_context_)) {
+            ShipContext(context);
+        }
+#endif
 
 #if LOGGER_ENABLE_SOURCE_LOCATION
         record.file = nullptr;
@@ -329,6 +867,33 @@ class Logger {
         return true;
     }
 
+#if LOGGER_ENABLE_CONTEXT
+    /**
+     * @brief Send the calling thread's context text ahead of the record about to be pushed
+     *
+     * On a full ring nothing is sent and the next record retries; until then
+     * the consumer renders records of this version without context.
+     */
+    LOGGER_NO_INLINE LOGGER_COLD void ShipContext(const LogContext &context) noexcept {
+        if (context.Version() == 0) {
+            shipped_context_ = 0; // empty stack: records carry id 0, nothing to cache
+            return;
+        }
+        LogRecord record;
+        record.level = Level::Fatal; // never filtered by the router: the channel consumes it
+        record.kind = RecordKind::Context;
+        record.continuations = 0;
+        record.sample_rate = 1;
+        record.timestamp = 0;
+        record.end_timestamp = 0;
+        record.context_id = context.Version();
+        record.SetMessage(context.Text(), context.Length());
+        if (ring_buffer_.TryPush(record)) {
+            shipped_context_ = context.Version();
+        }
+    }
+#endif
+
     /**
      * @brief Push a prepared record to the ring buffer
      * @param record The record to push
@@ -340,27 +905,138 @@ class Logger {
             return LogResult::Success;
         }
 
+        return DropRecord();
+    }
+
+    /**
+     * @brief true if the message filled its record and the policy lets it span more slots
+     *
+     * A message of exactly LOGGER_MAX_MESSAGE_SIZE - 1 bytes also takes the
+     * slow path, which then pushes it as a single record.
+     */
+    LOGGER_FORCE_INLINE bool Overflows(const LogRecord &record) const noexcept {
+        return record.message_length == LOGGER_MAX_MESSAGE_SIZE - 1 && LOGGER_MAX_RECORD_SPAN > 1 &&
+               long_messages_ == LongMessagePolicy::Span;
+    }
+
+    /**
+     * @brief Format the whole message of an overflowing record again, then push it spanning slots
+     */
+    template <typename... Args>
+    LOGGER_NO_INLINE LOGGER_COLD LogResult PushFormatted(LogRecord &record, const char *fmt, Args... args) noexcept {
+        char text[kMaxSpannedMessageSize + 1];
+        const int result = std::snprintf(text, sizeof(text), fmt, args...);
+        if (result < 0) {
+            return PushRecord(record);
+        }
+        return PushSpanned(record, text, std::min(static_cast<std::size_t>(result), kMaxSpannedMessageSize));
+    }
+
+    /**
+     * @brief Push a prepared record whose text is `text`, followed by continuation slots for the rest
+     *
+     * The record and its continuations are published with one release store,
+     * so the consumer never sees a partial message.
+     */
+    LOGGER_NO_INLINE LOGGER_COLD LogResult PushSpanned(LogRecord &record, const char *text,
+                                                       std::size_t length) noexcept {
+        length = std::min(length, kMaxSpannedMessageSize);
+        const std::size_t continuations = LogRecord::ContinuationsFor(length);
+        if (continuations == 0) {
+            record.SetMessage(text, length);
+            return PushRecord(record);
+        }
+        if (ring_buffer_.FreeSlots() < 1 + continuations) {
+            return DropRecord();
+        }
+        record.SetMessage(text, LOGGER_MAX_MESSAGE_SIZE - 1);
+        record.continuations = static_cast<std::uint16_t>(continuations);
+        record.total_length = static_cast<std::uint32_t>(length);
+        ring_buffer_.StageAt(0, record);
+
+        record.kind = RecordKind::Continuation;
+        record.continuations = 0;
+        std::size_t offset = LOGGER_MAX_MESSAGE_SIZE - 1;
+        for (std::size_t slot = 1; slot <= continuations; ++slot) {
+            const std::size_t part = std::min<std::size_t>(LOGGER_MAX_MESSAGE_SIZE, length - offset);
+            std::memcpy(record.message, text + offset, part); // continuation slots are not terminated
+            record.message_length = part;
+            ring_buffer_.StageAt(slot, record);
+            offset += part;
+        }
+        ring_buffer_.PublishStaged(1 + continuations);
+        return LogResult::Success;
+    }
+
+    /**
+     * @brief Account for a record dropped because the ring is full
+     *
+     * Out of line and cold so call sites only carry a call instruction; the
+     * consumer reports the count (Channel::ReportDrops), keeping stderr I/O
+     * off the producer.
+     */
+    LOGGER_NO_INLINE LOGGER_COLD LogResult DropRecord() noexcept {
         // Buffer is full - drop the log
         // This is the backpressure strategy: drop when full
-#if LOGGER_ENABLE_STDERR_DIAGNOSTICS
-        // Optionally report dropped logs (only if enabled)
-        // Note: This uses stderr, which may have some overhead
-        // this is to know how many logs are dropped when buffer is full
-        static std::atomic<std::size_t> dropped_count{0};
-        //.fetch_add(x,memory_order) return old value
-        std::size_t dropped = dropped_count.fetch_add(1, std::memory_order_relaxed) + 1;
-        if (dropped == 1 || (dropped % 1000 == 0)) {
-            // Only log first drop and every 1000th drop to avoid spam
-            std::fprintf(stderr, "[LOGGER] Warning: Log buffer full, dropped %zu log(s)\n", dropped);
-        }
-#endif
+        channel_.CountDrop();
         return LogResult::BufferFull;
     }
 
     internal::SpscRingBuffer<LogRecord, Capacity> ring_buffer_;
-    Consumer<Capacity> consumer_;
+    RingChannel<Capacity> channel_;
+    Consumer consumer_;           // idle when a backend drains the channel
+    Backend *backend_ = nullptr;
+    int shard_ = -1;
+    std::atomic<bool> registered_{false};
+    std::atomic<Level> min_level_{Level::Trace};
+#if LOGGER_ENABLE_CONTEXT
+    std::uint64_t shipped_context_ = 0; // producer only: last context version sent down the ring
+#endif
+    LevelSampler sampler_;
+    LongMessagePolicy long_messages_ =
+        LOGGER_MAX_RECORD_SPAN > 1 ? LongMessagePolicy::Span : LongMessagePolicy::Truncate; // producer only
 };
 
 } // namespace logger
 
+/**
+ * @brief Log a printf-style message if `level` passes both filters; otherwise evaluate nothing
+ *
+ * Unlike a LogFormat() call, the format arguments are evaluated only after
+ * the compile-time floor and IsEnabled() accept the level, so a filtered
+ * call costs one relaxed load and a compare. The filtered branch is marked
+ * unlikely, keeping the logging call on the fall-through path. The call
+ * site is captured with LLL_HERE (file name only).
+ *
+ * Example:
+ *   LLL_LOG(log, logger::Level::Info, "fill px=%f qty=%d", px, qty);
+ */
+#define LLL_LOG(instance, level, ...)                                             \
+    do {                                                                          \
+        if (LOGGER_UNLIKELY(!(instance).IsEnabled(level))) LOGGER_ATTR_UNLIKELY { \
+        } else {                                                                  \
+            (void)(instance).LogFormat((level), LLL_HERE, __VA_ARGS__);           \
+        }                                                                         \
+    } while (0)
+
+/**
+ * @brief LLL_LOG at a fixed level; nothing is generated below LOGGER_COMPILE_TIME_MIN_LEVEL
+ *
+ * Example:
+ *   LLL_DEBUG(log, "book depth %zu", book.Depth());  // Depth() not called unless Debug is on
+ */
+#define LLL_LOG_AT_(instance, level, ...)                                             \
+    do {                                                                              \
+        if constexpr (::logger::ShouldLog((level), ::logger::kCompileTimeMinLevel)) { \
+            LLL_LOG(instance, level, __VA_ARGS__);                                    \
+        }                                                                             \
+    } while (0)
+
+#define LLL_TRACE(instance, ...) LLL_LOG_AT_(instance, ::logger::Level::Trace, __VA_ARGS__)
+#define LLL_DEBUG(instance, ...) LLL_LOG_AT_(instance, ::logger::Level::Debug, __VA_ARGS__)
+#define LLL_INFO(instance, ...) LLL_LOG_AT_(instance, ::logger::Level::Info, __VA_ARGS__)
+#define LLL_WARN(instance, ...) LLL_LOG_AT_(instance, ::logger::Level::Warn, __VA_ARGS__)
+#define LLL_ERROR(instance, ...) LLL_LOG_AT_(instance, ::logger::Level::Error, __VA_ARGS__)
+#define LLL_FATAL(instance, ...) LLL_LOG_AT_(instance, ::logger::Level::Fatal, __VA_ARGS__)
+
 #endif // LOGGER_LOGGER_H
@@ -0,0 +1,138 @@
+/**
+ * @file memory_sink.h
+ * @brief In-memory ring of recent output, dumped to a file on demand
+ *
+ * Defines MemoryRingSink, which keeps the last N bytes of formatted output
+ * in a preallocated circular buffer without touching disk, and writes a
+ * consistent snapshot to a file on request (API call, signal or Fatal record).
+ *
+ * RESPONSIBILITIES:
+ * - Overwrite the oldest output in place (no allocation after construction)
+ * - Produce consistent dumps from any thread while writes continue
+ * - Dump on RequestDump() (async-signal-safe) or on a Fatal record
+ *
+ * ANTI-RESPONSIBILITIES:
+ * - No formatting (formatter's job)
+ * - No persistence except explicit dumps
+ */
+
+#ifndef LOGGER_MEMORY_SINK_H
+#define LOGGER_MEMORY_SINK_H
+
+#include "../internal/cacheline.h"
+#include "level.h"
+#include "sink.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace logger {
+
+/**
+ * @brief Circular in-memory sink with consistent on-demand dumps
+ *
+ * Write() runs on the consumer thread. DumpTo() may run on any thread; it
+ * validates each copied chunk against the writer's claim counter
+ * (seqlock style), so the dump never contains torn, half-overwritten data.
+ * The buffer is accessed through relaxed word atomics on both sides, so the
+ * overlap the seqlock tolerates is not a data race.
+ */
+class alignas(internal::kCacheLineSize) MemoryRingSink final : public Sink {
+  public:
+    /**
+     * @param capacity Bytes of output to retain
+     * @param dump_path Base path for triggered dumps (written as "<dump_path>.<n>"), may be null
+     * @param dump_on_fatal Dump automatically after a Fatal record is written
+     */
+    explicit MemoryRingSink(std::size_t capacity, const char *dump_path = nullptr, bool dump_on_fatal = true) noexcept;
+
+    /**
+     * @brief Detaches from every signal routed here, restoring its previous disposition
+     */
+    ~MemoryRingSink() override;
+
+    void Write(const char *data, std::size_t len) override;
+
+    /**
+     * @brief Nothing to flush; services pending dump requests
+     */
+    void Flush() override;
+
+    /**
+     * @brief Dumps when a Fatal record was written and dump_on_fatal is set
+     */
+    void OnSevere(Level level) override;
+
+    /**
+     * @brief Write the retained output to `path` (any thread)
+     *
+     * Output starts at the first complete line. If the writer laps the
+     * dump, the overwritten span is replaced by a marker line. Dumps share
+     * one preallocated copy buffer: a dump started while another is running
+     * fails instead of waiting.
+     *
+     * @return true if the file was written
+     */
+    bool DumpTo(const char *path) const;
+
+    /**
+     * @brief Ask the consumer to dump at its next Write()/Flush()
+     *
+     * Async-signal-safe (single lock-free atomic store).
+     */
+    void RequestDump() noexcept {
+        dump_requested_.store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Route `signo` to RequestDump() on this sink (POSIX only)
+     *
+     * The sink's destructor gives the signal back to the handler it had
+     * before; installing another sink on the same signal takes it over.
+     *
+     * @return false if signals are unsupported or installation failed
+     */
+    bool InstallDumpSignal(int signo) noexcept;
+
+    /**
+     * @brief Total bytes ever written (including overwritten bytes)
+     */
+    std::uint64_t TotalBytes() const noexcept {
+        return committed_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Number of dumps completed by triggers (requests and Fatal records)
+     */
+    std::uint32_t TriggeredDumps() const noexcept {
+        return dump_count_.load(std::memory_order_relaxed);
+    }
+
+    std::size_t Capacity() const noexcept {
+        return capacity_;
+    }
+
+  private:
+    void DumpTriggered();
+    bool DumpLocked(const char *path) const;
+
+    std::unique_ptr<std::atomic<std::uint64_t>[]> buffer_; // capacity_ bytes, rounded up to whole words
+    std::size_t capacity_;
+    std::unique_ptr<char[]> chunk_; // dump copy buffer, owned by the dump in progress
+    char dump_path_[256];
+    bool dump_on_fatal_;
+
+    // Writer claims [committed_, claimed_) before copying, then commits.
+    std::atomic<std::uint64_t> claimed_{0};
+    std::atomic<std::uint64_t> committed_{0};
+
+    std::atomic<bool> dump_requested_{false};
+    mutable std::atomic<bool> dumping_{false};
+    std::atomic<std::uint32_t> dump_count_{0};
+};
+
+} // namespace logger
+
+#endif // LOGGER_MEMORY_SINK_H
@@ -8,6 +8,7 @@
  * RESPONSIBILITIES:
  * - Fixed-size, POD-like structure
  * - In-place message storage (no heap allocation)
+ * - Continuation slots for the rare message longer than one record
  * - Cache-line aligned for efficient ring buffer storage
  *
  * ANTI-RESPONSIBILITIES:
@@ -20,6 +21,7 @@
 #define LOGGER_RECORD_H
 
 #include "../internal/cacheline.h"
+#include "../internal/endian.h"
 #include "config.h"
 #include "level.h"
 
@@ -30,6 +32,54 @@
 
 namespace logger {
 
+/**
+ * @brief What the consumer should render for a record
+ */
+enum class RecordKind : std::uint8_t {
+    Message,      // `message` is the text
+    ScopeTimer,   // `message` is a scope name; duration is end_timestamp - timestamp
+    Context,      // `message` is the text of context `context_id`; consumed by the Channel, never formatted
+    Binary,       // `message` is one chunk of a raw byte payload (see LogRecord::SetBinaryChunk)
+    Continuation, // `message` continues the text of the record before it; consumed by the Channel
+    Literal,      // `external_text` points to a string literal (StaticString); `message` is unused
+};
+
+/**
+ * @brief What the producer does with a message longer than one record holds
+ */
+enum class LongMessagePolicy : std::uint8_t {
+    Truncate, // cut at LOGGER_MAX_MESSAGE_SIZE - 1 bytes
+    Span,     // continue in up to LOGGER_MAX_RECORD_SPAN - 1 extra slots, cut at kMaxSpannedMessageSize
+};
+
+/**
+ * @brief Longest message text once a record spans LOGGER_MAX_RECORD_SPAN slots
+ *
+ * The first slot keeps its '\0' terminator; continuation slots are filled
+ * completely.
+ */
+inline constexpr std::size_t kMaxSpannedMessageSize = LOGGER_MAX_RECORD_SPAN * LOGGER_MAX_MESSAGE_SIZE - 1;
+
+static_assert(LOGGER_MAX_RECORD_SPAN >= 1 && LOGGER_MAX_RECORD_SPAN <= 0xFFFF,
+              "LOGGER_MAX_RECORD_SPAN must be in [1, 65535]");
+
+/**
+ * @brief Bytes before the label in a RecordKind::Binary message
+ *
+ * Layout: u32 offset of this chunk in the payload, u32 total payload size
+ * (little-endian), label, '\0', raw bytes. The same bytes are stored in
+ * binary log files, so offline tools render payloads like the live formatter.
+ */
+inline constexpr std::size_t kBinaryChunkHeaderSize = 8;
+
+/**
+ * @brief Longest label stored with a binary payload (longer labels are cut)
+ */
+inline constexpr std::size_t kMaxBinaryLabel = 64;
+
+static_assert(LOGGER_MAX_MESSAGE_SIZE >= kBinaryChunkHeaderSize + kMaxBinaryLabel + 2 + 16,
+              "LOGGER_MAX_MESSAGE_SIZE too small for binary payload chunks");
+
 /**
  * @brief Fixed-size log record structure
  *
@@ -37,31 +87,42 @@ namespace logger {
  * minimal latency. All data is stored inline with no heap allocation.
  *
  * Layout is cache-line aligned to prevent false sharing in the ring buffer.
+ * The header is packed: the fields every push writes fill the first cache
+ * line, the optional thread/source fields start the second, and `message`
+ * follows them directly. The ring copies only StoredSize() bytes, so a push
+ * of a short message writes two cache lines of its slot.
  */
 struct alignas(internal::kCacheLineSize) LogRecord {
-    /*Core fields (always present/necessary)*/
+    /*Core fields (always present/necessary): first cache line*/
 
-    Level level;                                                                 // 1 byte
-    internal::CachelinePad<sizeof(Level)> padding1;                              // (alignment)
-    std::uint64_t timestamp;                                                     // 8 bytes (TSC or nanoseconds)
-    std::size_t message_length;                                                  // 8 bytes
-    internal::CachelinePad<sizeof(timestamp) + sizeof(message_length)> padding2; // (alignment)
+    Level level;                  // 1 byte
+    RecordKind kind;              // 1 byte
+    std::uint16_t continuations;  // 2 bytes (RecordKind::Continuation slots that follow; 0 = single slot)
+    std::uint32_t total_length;   // 4 bytes (length of the whole text when continuations != 0)
+    std::uint64_t timestamp;      // 8 bytes (TSC or nanoseconds)
+    std::uint64_t end_timestamp;  // 8 bytes (ScopeTimer: TSC at exit)
+    std::size_t message_length;   // 8 bytes
+    std::uint32_t sample_rate;    // 4 bytes (1 = not sampled)
+#if LOGGER_ENABLE_CONTEXT
+    std::uint32_t context_length; // 4 bytes, set by the consumer: length of `context`
+#endif
+    const char *external_text; // 8 bytes, text outside the record (nullptr = message): a literal
+                               // (producer, RecordKind::Literal) or a reassembled spanning record (consumer)
+#if LOGGER_ENABLE_CONTEXT
+    std::uint64_t context_id;      // 8 bytes, producer's LogContext version (0 = none)
+    const char *context;           // 8 bytes, set by the consumer: cached text of context_id
+#endif
 
-    /*Optional fields (conditionally compiled)*/
+    /*Optional fields (conditionally compiled): second cache line*/
 
 #if LOGGER_ENABLE_THREAD_ID
     std::uint64_t thread_id; // 8 bytes
-    internal::CachelinePad<sizeof(thread_id)> padding3;
 #endif
 
 #if LOGGER_ENABLE_SOURCE_LOCATION
-    const char *file;                                      // pointer to __FILE__ (static string)
-    internal::CachelinePad<sizeof(file)> padding_file;     // pad to cache line
-    const char *function;                                  // pointer to __func__ (static string)
-    internal::CachelinePad<sizeof(function)> padding_func; // pad to cache line
-    std::int32_t line;                                     // line number from __LINE__
-    internal::CachelinePad<sizeof(line)> padding_line;     // pad to cache line
-
+    const char *file;     // pointer to __FILE__ (static string)
+    const char *function; // pointer to __func__ (static string)
+    std::int32_t line;    // line number from __LINE__
 #endif
 
     /*Message payload (fixed-size buffer)*/
@@ -152,6 +213,60 @@ struct alignas(internal::kCacheLineSize) LogRecord {
         return message_length;
     }
 
+    /**
+     * @brief The message text: `external_text` for literals and reassembled spanning records, else `message`
+     */
+    const char *MessageData() const noexcept {
+        return external_text ? external_text : message;
+    }
+
+    /**
+     * @brief Leading bytes that carry data: the header plus the used part of `message`
+     *
+     * The ring copies only these into and out of a slot (see SpscRingBuffer).
+     * A RecordKind::Literal keeps its text outside the record.
+     */
+    std::size_t StoredSize() const noexcept {
+        const std::size_t used = message_length < sizeof(message) ? message_length + 1 : sizeof(message);
+        return offsetof(LogRecord, message) + (kind == RecordKind::Literal ? 0 : used);
+    }
+
+    /**
+     * @brief RecordKind::Continuation slots needed after the first one for `length` bytes of text
+     */
+    static constexpr std::size_t ContinuationsFor(std::size_t length) noexcept {
+        // ceil((length - (MAX - 1)) / MAX), which reduces to length / MAX
+        return length / LOGGER_MAX_MESSAGE_SIZE;
+    }
+
+    /**
+     * @brief Raw payload bytes one RecordKind::Binary record carries next to a label
+     */
+    static constexpr std::size_t BinaryChunkCapacity(std::size_t label_length) noexcept {
+        // Whole dump lines per chunk, so consecutive chunks line up.
+        return (LOGGER_MAX_MESSAGE_SIZE - 1 - kBinaryChunkHeaderSize - label_length - 1) / 16 * 16;
+    }
+
+    /**
+     * @brief Store one chunk of a binary payload (no formatting, one memcpy)
+     * @param label Label text (label_length <= kMaxBinaryLabel)
+     * @param data Chunk bytes (length <= BinaryChunkCapacity(label_length))
+     * @param offset Offset of the chunk in the whole payload
+     * @param total Size of the whole payload
+     * @return Number of message bytes written
+     */
+    std::size_t SetBinaryChunk(const char *label, std::size_t label_length, const void *data, std::size_t length,
+                               std::uint32_t offset, std::uint32_t total) noexcept {
+        unsigned char *out = reinterpret_cast<unsigned char *>(message);
+        internal::StoreLe32(out, offset);
+        internal::StoreLe32(out + 4, total);
+        std::memcpy(message + kBinaryChunkHeaderSize, label, label_length);
+        message[kBinaryChunkHeaderSize + label_length] = '\0';
+        std::memcpy(message + kBinaryChunkHeaderSize + label_length + 1, data, length);
+        message_length = kBinaryChunkHeaderSize + label_length + 1 + length;
+        return message_length;
+    }
+
 #if LOGGER_ENABLE_SOURCE_LOCATION
     /**
      * @brief Set source location information
@@ -173,6 +288,17 @@ struct alignas(internal::kCacheLineSize) LogRecord {
 static_assert(alignof(LogRecord) >= internal::kCacheLineSize,
               "LogRecord must be cache-line aligned");
 
+// Ensure a push writes its header into at most two cache lines
+#if LOGGER_ENABLE_CONTEXT
+static_assert(offsetof(LogRecord, context) + sizeof(LogRecord::context) <= internal::kCacheLineSize,
+              "LogRecord core fields must fit the first cache line");
+#else
+static_assert(offsetof(LogRecord, external_text) + sizeof(LogRecord::external_text) <= internal::kCacheLineSize,
+              "LogRecord core fields must fit the first cache line");
+#endif
+static_assert(offsetof(LogRecord, message) <= 2 * internal::kCacheLineSize,
+              "LogRecord header must fit two cache lines");
+
 // Ensure LogRecord fits reasonable size (warn if too large)
 static_assert(sizeof(LogRecord) <= 4096,
               "LogRecord is very large, consider reducing LOGGER_MAX_MESSAGE_SIZE");
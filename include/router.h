@@ -0,0 +1,135 @@
+/**
+ * @file router.h
+ * @brief Fan-out of formatted records to several (Formatter, Sink, Level) destinations
+ *
+ * Defines the Router used by the consumer to deliver each record to every
+ * destination whose minimum level it meets.
+ *
+ * RESPONSIBILITIES:
+ * - Group destinations by formatter so a record is formatted once per distinct formatter
+ * - Write the formatted bytes to every matching sink
+ * - Flush each distinct sink exactly once
+ * - Keep the single-destination case a straight format + write
+ *
+ * ANTI-RESPONSIBILITIES:
+ * - No ownership of formatters or sinks (references only)
+ * - No threading (called only from the consumer thread)
+ * - No allocation (destinations stored in fixed arrays)
+ */
+
+#ifndef LOGGER_ROUTER_H
+#define LOGGER_ROUTER_H
+
+#include "../internal/platform.h"
+#include "config.h"
+#include "formatter.h"
+#include "level.h"
+#include "record.h"
+#include "sink.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace logger {
+
+/**
+ * @brief One output of the consumer: records at or above min_level are
+ * formatted by `formatter` and written to `sink`
+ *
+ * The formatter and sink must outlive the Router. The same formatter or
+ * sink may appear in several destinations.
+ */
+struct Destination {
+    Formatter *formatter;
+    Sink *sink;
+    Level min_level;
+};
+
+/**
+ * @brief Routes records to one or more destinations
+ *
+ * Not thread-safe; owned by the consumer.
+ */
+class Router {
+  public:
+    /**
+     * @brief Single destination accepting every level
+     */
+    Router(Formatter &formatter, Sink &sink) noexcept;
+
+    /**
+     * @brief Multiple destinations
+     * @param destinations Array of destinations (copied)
+     * @param count Number of destinations; entries beyond
+     *        LOGGER_MAX_DESTINATIONS or with null members are ignored
+     */
+    Router(const Destination *destinations, std::size_t count) noexcept;
+
+    // Non-copyable, Non-movable
+    Router(const Router &) = delete;
+    Router &operator=(const Router &) = delete;
+    Router(Router &&) = delete;
+    Router &operator=(Router &&) = delete;
+
+    /**
+     * @brief Format and write a record to every matching destination
+     * @param record Record to deliver
+     * @param scratch Formatting buffer
+     * @param capacity Size of the formatting buffer
+     * @return Total number of bytes written across all sinks
+     */
+    LOGGER_FORCE_INLINE std::size_t Dispatch(const LogRecord &record, char *scratch, std::size_t capacity) {
+        if (LOGGER_LIKELY(destination_count_ == 1)) {
+            const Destination &only = destinations_[0];
+            if (!ShouldLog(record.level, only.min_level)) {
+                return 0;
+            }
+            const std::size_t len = only.formatter->FormatRecord(record, scratch, capacity);
+            only.sink->Write(scratch, len);
+            if (LOGGER_UNLIKELY(ShouldLog(record.level, Level::Error))) {
+                only.sink->OnSevere(record.level);
+            }
+            return len;
+        }
+        return DispatchFanOut(record, scratch, capacity);
+    }
+
+    /**
+     * @brief Flush every distinct sink once
+     */
+    void Flush() {
+        for (std::size_t i = 0; i < sink_count_; ++i) {
+            sinks_[i]->Flush();
+        }
+    }
+
+    /**
+     * @brief Number of active destinations
+     */
+    std::size_t DestinationCount() const noexcept {
+        return destination_count_;
+    }
+
+  private:
+    // Destinations sharing a formatter, contiguous in destinations_.
+    struct FormatterGroup {
+        Formatter *formatter;
+        Level min_level; // lowest min_level of the group's destinations
+        std::uint8_t begin;
+        std::uint8_t end;
+    };
+
+    void AddDestinations(const Destination *destinations, std::size_t count) noexcept;
+    std::size_t DispatchFanOut(const LogRecord &record, char *scratch, std::size_t capacity);
+
+    Destination destinations_[LOGGER_MAX_DESTINATIONS];
+    FormatterGroup groups_[LOGGER_MAX_DESTINATIONS];
+    Sink *sinks_[LOGGER_MAX_DESTINATIONS];
+    std::size_t destination_count_;
+    std::size_t group_count_;
+    std::size_t sink_count_;
+};
+
+} // namespace logger
+
+#endif // LOGGER_ROUTER_H
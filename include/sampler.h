@@ -0,0 +1,193 @@
+/**
+ * @file sampler.h
+ * @brief Producer-side sampling of high-volume log statements
+ *
+ * Defines sampling policies that decide, before any record is prepared,
+ * whether a log call is kept. A skipped call costs one counter update
+ * (deterministic mode) or one thread-local xorshift step (random mode).
+ *
+ * RESPONSIBILITIES:
+ * - 1-in-N deterministic sampling (counter based)
+ * - 1-in-N randomized sampling (thread-local xorshift64*)
+ * - Per-level policies (LevelSampler) and per-callsite policies (SamplePoint)
+ *
+ * ANTI-RESPONSIBILITIES:
+ * - No formatting, no I/O
+ * - No synchronization (policies are owned by the single producer)
+ */
+
+#ifndef LOGGER_SAMPLER_H
+#define LOGGER_SAMPLER_H
+
+#include "../internal/platform.h"
+#include "level.h"
+#include "source_location.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace logger {
+
+/**
+ * @brief How a sampled log statement picks the calls it keeps
+ */
+enum class SamplingMode : std::uint8_t {
+    None = 0,      // Keep every call
+    Deterministic, // Keep the first call, then every Nth call
+    Random         // Keep each call with probability 1/N
+};
+
+/**
+ * @brief Sampling configuration: keep 1 in `rate` calls using `mode`
+ */
+struct SamplingPolicy {
+    SamplingMode mode;
+    std::uint32_t rate;
+};
+
+namespace internal {
+
+/**
+ * @brief Cheap per-thread pseudo random number (xorshift64*)
+ *
+ * State is thread-local so producers never share a cache line.
+ * The first call on a thread seeds from the TSC and the state address.
+ */
+LOGGER_FORCE_INLINE std::uint64_t NextRandom() noexcept {
+    static LOGGER_THREAD_LOCAL std::uint64_t state = 0;
+    if (LOGGER_UNLIKELY(state == 0)) {
+        state = (ReadTsc() ^ reinterpret_cast<std::uintptr_t>(&state)) | 1u;
+    }
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+ * @brief Decide whether a call is kept under the given policy
+ * @param policy Sampling policy
+ * @param counter Per-policy countdown (deterministic mode only)
+ * @return true if the call should be logged
+ */
+LOGGER_FORCE_INLINE bool AdmitSample(const SamplingPolicy &policy, std::uint32_t &counter) noexcept {
+    if (LOGGER_LIKELY(policy.mode == SamplingMode::None || policy.rate <= 1)) {
+        return true;
+    }
+    if (policy.mode == SamplingMode::Deterministic) {
+        // Countdown keeps the first call and then every rate-th call.
+        if (counter == 0) {
+            counter = policy.rate - 1;
+            return true;
+        }
+        --counter;
+        return false;
+    }
+    // Map the top 32 random bits onto [0, rate); keep only bucket 0.
+    const std::uint64_t bits = NextRandom() >> 32;
+    return ((bits * policy.rate) >> 32) == 0;
+}
+
+} // namespace internal
+
+/**
+ * @brief Per-level sampling policies owned by a Logger
+ *
+ * Configure before logging starts or from the producer thread; the
+ * policies are read without synchronization on the hot path.
+ */
+class LevelSampler {
+  public:
+    LevelSampler() noexcept {
+        for (std::size_t i = 0; i < kLevelCount; ++i) {
+            policies_[i] = SamplingPolicy{SamplingMode::None, 1};
+            counters_[i] = 0;
+        }
+    }
+
+    /**
+     * @brief Set the sampling policy for one level
+     * @param level Level to configure
+     * @param mode Sampling mode (None disables sampling)
+     * @param rate Keep 1 in `rate` calls (0 and 1 disable sampling)
+     */
+    void Set(Level level, SamplingMode mode, std::uint32_t rate) noexcept {
+        const std::size_t index = LevelToInt(level);
+        policies_[index] = SamplingPolicy{mode, rate == 0 ? 1 : rate};
+        counters_[index] = 0;
+    }
+
+    /**
+     * @brief Get the sampling policy for one level
+     */
+    SamplingPolicy Get(Level level) const noexcept {
+        return policies_[LevelToInt(level)];
+    }
+
+    /**
+     * @brief Decide whether a call at `level` is kept
+     * @param level Level of the call
+     * @param[out] rate Sampling rate to stamp into the record (1 if unsampled)
+     * @return true if the call should be logged
+     */
+    LOGGER_FORCE_INLINE bool Admit(Level level, std::uint32_t &rate) noexcept {
+        const std::size_t index = LevelToInt(level);
+        const SamplingPolicy &policy = policies_[index];
+        rate = (policy.mode == SamplingMode::None) ? 1 : policy.rate;
+        return internal::AdmitSample(policy, counters_[index]);
+    }
+
+  private:
+    SamplingPolicy policies_[kLevelCount];
+    std::uint32_t counters_[kLevelCount];
+};
+
+/**
+ * @brief Sampling state for a single callsite
+ *
+ * Usually declared as a function-local thread_local by LLL_LOG_SAMPLED so
+ * each producer thread keeps its own countdown. Constant-initialized and
+ * trivially destructible, so thread_local access needs no guard.
+ */
+class SamplePoint {
+  public:
+    constexpr SamplePoint(SamplingMode mode, std::uint32_t rate) noexcept
+        : policy_{mode, rate == 0 ? 1u : rate}, counter_(0) {}
+
+    /**
+     * @brief Decide whether this call is kept
+     */
+    LOGGER_FORCE_INLINE bool Admit() noexcept {
+        return internal::AdmitSample(policy_, counter_);
+    }
+
+    /**
+     * @brief Sampling rate to stamp into kept records (1 if unsampled)
+     */
+    std::uint32_t Rate() const noexcept {
+        return (policy_.mode == SamplingMode::None) ? 1 : policy_.rate;
+    }
+
+  private:
+    SamplingPolicy policy_;
+    std::uint32_t counter_;
+};
+
+} // namespace logger
+
+/**
+ * @def LLL_LOG_SAMPLED(instance, level, mode, rate, fmt, ...)
+ * @brief Log a printf-style message through a per-callsite sampler
+ *
+ * Usage:
+ *   LLL_LOG_SAMPLED(log, logger::Level::Trace, logger::SamplingMode::Random, 100, "px=%f", px);
+ *
+ * Skipped calls never prepare a record, capture a timestamp or format.
+ */
+#define LLL_LOG_SAMPLED(instance, level, mode, rate, ...)                                                        \
+    do {                                                                                                         \
+        static LOGGER_THREAD_LOCAL ::logger::SamplePoint lll_sample_point_((mode), (rate));                      \
+        (void)(instance).LogSampled(lll_sample_point_, (level), LLL_FILE_NAME, __LINE__, __func__, __VA_ARGS__); \
+    } while (0)
+
+#endif // LOGGER_SAMPLER_H
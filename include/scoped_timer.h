@@ -0,0 +1,125 @@
+/**
+ * @file scoped_timer.h
+ * @brief RAII latency measurement of a scope, logged with TSC precision
+ *
+ * Defines ScopedTimer, which reads the TSC when a scope is entered and when
+ * it is left, and pushes both raw readings with the scope name as one record
+ * (RecordKind::ScopeTimer). The consumer converts the delta to nanoseconds
+ * while formatting, so the producer pays two ReadTsc() calls, a compare and
+ * a record copy: no clock conversion, no printf.
+ *
+ * RESPONSIBILITIES:
+ * - Capture entry/exit TSC around a scope
+ * - Suppress scopes faster than a threshold (compared in ticks, on the producer)
+ * - Skip the TSC reads entirely when the level is filtered at entry
+ *
+ * ANTI-RESPONSIBILITIES:
+ * - No formatting (RecordPayload() renders the duration on the consumer)
+ * - No aggregation of durations across calls
+ */
+
+#ifndef LOGGER_SCOPED_TIMER_H
+#define LOGGER_SCOPED_TIMER_H
+
+#include "../internal/clock.h"
+#include "../internal/platform.h"
+#include "level.h"
+#include "source_location.h"
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace logger {
+
+/**
+ * @brief Logs how long the enclosing scope took when it exits
+ *
+ * @tparam LoggerT Any type with IsEnabled(Level) and LogScopeTimer() (Logger<N>)
+ */
+template <typename LoggerT>
+class ScopedTimer {
+  public:
+    /**
+     * @param logger Destination logger (must outlive the timer)
+     * @param name Scope name; must stay valid until the timer is destroyed
+     * @param level Level of the emitted record
+     * @param threshold_ticks Scopes shorter than this many TSC ticks are not logged
+     *        (see ThresholdTicks())
+     * @param file Source file name (nullptr for none)
+     * @param line Line number
+     * @param function Function name (nullptr for none)
+     */
+    ScopedTimer(LoggerT &logger, const char *name, Level level = Level::Info, std::uint64_t threshold_ticks = 0,
+                const char *file = nullptr, int line = 0, const char *function = nullptr) noexcept
+        : logger_(logger.IsEnabled(level) ? &logger : nullptr),
+          name_(name),
+          level_(level),
+          line_(line),
+          threshold_ticks_(threshold_ticks),
+          file_(file),
+          function_(function),
+          start_(logger_ ? internal::ReadTsc() : 0) {}
+
+    ~ScopedTimer() {
+        if (!logger_) {
+            return;
+        }
+        const std::uint64_t end = internal::ReadTsc();
+        if (end - start_ < threshold_ticks_) {
+            return;
+        }
+        (void)logger_->LogScopeTimer(level_, name_, std::strlen(name_), start_, end, file_, line_, function_);
+    }
+
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+    /**
+     * @brief Convert a nanosecond threshold to ticks once, outside the measured path
+     */
+    static std::uint64_t ThresholdTicks(std::uint64_t threshold_ns) noexcept {
+        return threshold_ns == 0 ? 0 : internal::NanosecondsToTsc(threshold_ns);
+    }
+
+  private:
+    LoggerT *logger_; // nullptr when the level was filtered at entry
+    const char *name_;
+    Level level_;
+    int line_;
+    std::uint64_t threshold_ticks_;
+    const char *file_;
+    const char *function_;
+    std::uint64_t start_;
+};
+
+} // namespace logger
+
+#define LLL_SCOPE_TIMER_JOIN_(a, b) a##b
+#define LLL_SCOPE_TIMER_NAME_(prefix, line) LLL_SCOPE_TIMER_JOIN_(prefix, line)
+
+/**
+ * @brief Log the duration of the rest of the enclosing scope
+ *
+ * Example:
+ *   void OnOrder() {
+ *       LLL_SCOPE_TIMER(log, logger::Level::Info, "on_order");
+ *       ...
+ *   } // -> "[ns] [INFO] file:line OnOrder on_order took 812 ns"
+ */
+#define LLL_SCOPE_TIMER(instance, level, name) LLL_SCOPE_TIMER_OVER(instance, level, name, 0)
+
+/**
+ * @brief LLL_SCOPE_TIMER that only logs scopes lasting at least `threshold_ns`
+ *
+ * The threshold is converted to ticks once per callsite (function-local static).
+ */
+#define LLL_SCOPE_TIMER_OVER(instance, level, name, threshold_ns)                                                    \
+    static const std::uint64_t LLL_SCOPE_TIMER_NAME_(lll_scope_threshold_, __LINE__) =                               \
+        ::logger::ScopedTimer<std::remove_reference_t<decltype(instance)>>::ThresholdTicks(threshold_ns);            \
+    ::logger::ScopedTimer<std::remove_reference_t<decltype(instance)>> LLL_SCOPE_TIMER_NAME_(lll_scope_timer_,       \
+                                                                                             __LINE__)(              \
+        (instance), (name), (level), LLL_SCOPE_TIMER_NAME_(lll_scope_threshold_, __LINE__), LLL_FILE_NAME, __LINE__, \
+        __func__)
+
+#endif // LOGGER_SCOPED_TIMER_H
@@ -18,10 +18,15 @@
 #define LOGGER_SINK_H
 
 #include "../internal/cacheline.h"
+#include "level.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
+#include <mutex>
+#include <thread>
 
 namespace logger {
 
@@ -61,6 +66,18 @@ class Sink {
      */
     virtual void Flush() = 0;
 
+    /**
+     * @brief Notification that the record just written is Error or Fatal
+     * @param level Level of that record
+     *
+     * Called by the consumer right after Write() for records at
+     * Level::Error or above. Default does nothing; sinks override it for
+     * severity-triggered actions (dumps, durable syncs).
+     */
+    virtual void OnSevere(Level level) {
+        (void)level;
+    }
+
     // Non-copyable, non-movable
     Sink(const Sink &) = delete;
     Sink &operator=(const Sink &) = delete;
@@ -72,14 +89,48 @@ class Sink {
     Sink() = default;
 };
 
+/**
+ * @brief When a FileSink forces written data to stable storage
+ *
+ * Syncs (fdatasync, F_FULLFSYNC on macOS) run on a background thread
+ * owned by the sink, never on the consumer. A sync covers data already
+ * handed to the kernel (fflush): by the consumer for the size and error
+ * triggers, by the sync thread itself for the time trigger.
+ */
+struct DurabilityPolicy {
+    enum class Mode : std::uint8_t {
+        None,        // fflush only; page cache may be lost on power failure
+        Periodic,    // sync every interval_ms and/or every interval_bytes
+        SyncOnError, // sync after every Error/Fatal record
+    };
+
+    Mode mode = Mode::None;
+    std::uint32_t interval_ms = 1000;  // Periodic: 0 disables the time trigger
+    std::uint64_t interval_bytes = 0;  // Periodic: 0 disables the size trigger
+};
+
+/**
+ * @brief Sync totals published by the FileSink sync thread
+ */
+struct SyncStats {
+    std::uint64_t syncs;        // Successful syncs
+    std::uint64_t failures;     // Failed syncs (also reported via ReportError)
+    std::uint64_t synced_bytes; // Bytes known to be on stable storage
+    std::uint64_t total_ns;     // Sum of sync latencies
+    std::uint64_t max_ns;       // Worst sync latency
+    std::uint64_t last_ns;      // Most recent sync latency
+};
+
 /**
  * @brief File-backed sink (append-only)
  *
- * Uses stdio buffering; called only from the consumer thread.
+ * Uses stdio buffering; called only from the consumer thread. With a
+ * DurabilityPolicy other than None, a sync thread makes flushed data
+ * durable without stalling the consumer.
  */
 class alignas(internal::kCacheLineSize) FileSink final : public Sink {
   public:
-    explicit FileSink(const char *path, const char *mode = "ab") noexcept;
+    explicit FileSink(const char *path, const char *mode = "ab", DurabilityPolicy policy = {}) noexcept;
     /* once base class deconstructor is virtual all of it's child classes are virtual as well so it runs even when compiler deletes sink obj.
        override keyword just to verify at compile time that base class also have virtual deconstructor
       override is not neccasary for deconstructor it will always overide virtual deconstructor from parent class
@@ -89,8 +140,45 @@ class alignas(internal::kCacheLineSize) FileSink final : public Sink {
     void Write(const char *data, std::size_t len) override;
     void Flush() override;
 
+    /**
+     * @brief Under SyncOnError, flush and wake the sync thread
+     */
+    void OnSevere(Level level) override;
+
+    /**
+     * @brief Snapshot of sync totals (safe from any thread)
+     */
+    SyncStats Stats() const noexcept;
+
   private:
+    void PublishFlushed(bool request_sync) noexcept;
+    void WakeSyncThread() noexcept;
+    void SyncLoop();
+    bool SyncOnce(std::uint64_t target);
+
     std::FILE *file_;
+    DurabilityPolicy policy_;
+    std::uint64_t written_ = 0;        // consumer only
+    std::uint64_t next_sync_bytes_ = 0; // consumer only
+
+    // Consumer -> sync thread: bytes handed to the kernel, and how far a sync is wanted.
+    std::atomic<std::uint64_t> flushed_{0};
+    std::atomic<std::uint64_t> sync_target_{0};
+    // Consumer -> sync thread: bytes passed to fwrite; the time trigger flushes these itself.
+    std::atomic<std::uint64_t> accepted_{0};
+
+    std::atomic<std::uint64_t> syncs_{0};
+    std::atomic<std::uint64_t> failures_{0};
+    std::atomic<std::uint64_t> synced_bytes_{0};
+    std::atomic<std::uint64_t> total_ns_{0};
+    std::atomic<std::uint64_t> max_ns_{0};
+    std::atomic<std::uint64_t> last_ns_{0};
+
+    std::atomic<bool> stopping_{false};
+    // The sync thread sleeps here between requests and time triggers.
+    std::mutex sync_mutex_;
+    std::condition_variable sync_cv_;
+    std::thread sync_thread_;
 };
 
 /**
@@ -0,0 +1,131 @@
+/**
+ * @file socket_sink.h
+ * @brief Sink that ships formatted output to a local daemon over a Unix domain socket
+ *
+ * Defines UnixSocketSink, which sends batched output with non-blocking
+ * writes and keeps whatever the peer cannot take yet in a preallocated
+ * spill buffer, so the consumer thread never blocks on the peer.
+ *
+ * RESPONSIBILITIES:
+ * - Batch output into a fixed-size spill ring (no allocation after construction)
+ * - Send with non-blocking writes (SOCK_STREAM or SOCK_SEQPACKET)
+ * - Reconnect with capped exponential backoff, attempted only when due
+ * - Drop new output (counted) when the spill ring is full
+ *
+ * ANTI-RESPONSIBILITIES:
+ * - No blocking I/O, no retries inside Write()
+ * - No formatting (formatter's job)
+ */
+
+#ifndef LOGGER_SOCKET_SINK_H
+#define LOGGER_SOCKET_SINK_H
+
+#include "../internal/cacheline.h"
+#include "../internal/platform.h"
+#include "sink.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#if defined(LOGGER_OS_POSIX)
+
+namespace logger {
+
+/**
+ * @brief Tuning knobs for UnixSocketSink
+ */
+struct UnixSocketSinkOptions {
+    enum class Type : std::uint8_t {
+        Stream,   // SOCK_STREAM: byte stream, partial sends resume mid-batch
+        SeqPacket // SOCK_SEQPACKET: each send is one packet of whole lines
+    };
+
+    Type type = Type::Stream;
+    std::size_t spill_capacity = 4 * 1024 * 1024; // Bytes held while the peer is slow or away
+    std::size_t batch_size = 64 * 1024;           // Max bytes per send (packet size for SeqPacket)
+    std::size_t send_threshold = 16 * 1024;       // Write() sends once this much is pending
+    std::uint32_t reconnect_initial_ms = 10;      // First reconnect delay
+    std::uint32_t reconnect_max_ms = 2000;        // Backoff cap
+};
+
+/**
+ * @brief Counters published by UnixSocketSink (readable from any thread)
+ */
+struct SocketSinkStats {
+    std::uint64_t sent_bytes;
+    std::uint64_t dropped_bytes;
+    std::uint64_t send_calls;
+    std::uint64_t connects;
+    std::uint64_t disconnects;
+};
+
+/**
+ * @brief Non-blocking Unix domain socket sink
+ *
+ * Called only from the consumer thread.
+ */
+class alignas(internal::kCacheLineSize) UnixSocketSink final : public Sink {
+  public:
+    explicit UnixSocketSink(const char *path, const UnixSocketSinkOptions &options = UnixSocketSinkOptions{}) noexcept;
+    ~UnixSocketSink() override;
+
+    /**
+     * @brief Queue data; sends when send_threshold bytes are pending
+     */
+    void Write(const char *data, std::size_t len) override;
+
+    /**
+     * @brief Send as much pending data as the peer accepts without blocking
+     *
+     * Data the peer cannot take yet stays in the spill ring.
+     */
+    void Flush() override;
+
+    /**
+     * @brief Bytes waiting in the spill ring (consumer thread only)
+     */
+    std::size_t PendingBytes() const noexcept {
+        return static_cast<std::size_t>(write_pos_ - read_pos_);
+    }
+
+    bool IsConnected() const noexcept {
+        return fd_ >= 0;
+    }
+
+    SocketSinkStats Stats() const noexcept;
+
+  private:
+    void TryConnect();
+    void Disconnect();
+    void SendPending();
+    bool SendStream();
+    bool SendPacket();
+
+    UnixSocketSinkOptions options_;
+    char path_[108]; // sizeof(sockaddr_un::sun_path) on Linux
+    int fd_;
+
+    // Spill ring: [read_pos_, write_pos_) are pending, positions are monotonic.
+    std::unique_ptr<char[]> spill_;
+    std::unique_ptr<char[]> packet_;
+    std::uint64_t read_pos_;
+    std::uint64_t write_pos_;
+
+    // Reconnect backoff (steady clock nanoseconds).
+    std::uint64_t next_connect_ns_;
+    std::uint32_t backoff_ms_;
+
+    std::atomic<std::uint64_t> sent_bytes_{0};
+    std::atomic<std::uint64_t> dropped_bytes_{0};
+    std::atomic<std::uint64_t> send_calls_{0};
+    std::atomic<std::uint64_t> connects_{0};
+    std::atomic<std::uint64_t> disconnects_{0};
+};
+
+} // namespace logger
+
+#endif // LOGGER_OS_POSIX
+
+#endif // LOGGER_SOCKET_SINK_H
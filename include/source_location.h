@@ -0,0 +1,121 @@
+/**
+ * @file source_location.h
+ * @brief Call-site capture with the directory stripped at compile time
+ *
+ * __FILE__ expands to the path the build system handed the compiler, often
+ * an absolute one, and the TextFormatter prints it verbatim. LLL_FILE_NAME
+ * is the same literal advanced past its last '/' or '\\', with the offset
+ * computed by a constexpr scan during compilation: the record still stores
+ * a single pointer into static storage and the consumer prints
+ * "foo.cpp:42" instead of "/home/build/.../src/foo.cpp:42".
+ *
+ * SourceLocation bundles file, line and function so a call site passes one
+ * argument (LLL_HERE) instead of __FILE__, __LINE__, __func__. On C++20
+ * compilers SourceLocation::Current() also captures the caller through
+ * std::source_location, which lets wrapper functions take
+ * `SourceLocation where = SourceLocation::Current()` as a default argument
+ * and log the location of *their* caller without any macro.
+ *
+ * RESPONSIBILITIES:
+ * - Compile-time basename of __FILE__ / std::source_location::file_name()
+ * - One value type for file, line, function
+ *
+ * ANTI-RESPONSIBILITIES:
+ * - No runtime path handling (the formatter prints what it is given)
+ * - No storage (all pointers refer to literals)
+ */
+
+#ifndef LOGGER_SOURCE_LOCATION_H
+#define LOGGER_SOURCE_LOCATION_H
+
+#include <cstddef>
+#include <type_traits>
+
+#if defined(__has_include)
+#if __has_include(<version>)
+#include <version>
+#endif
+#endif
+
+/**
+ * @def LOGGER_HAS_STD_SOURCE_LOCATION
+ * @brief 1 when std::source_location is available (C++20)
+ */
+#if defined(__cpp_lib_source_location)
+#define LOGGER_HAS_STD_SOURCE_LOCATION 1
+#include <source_location>
+#else
+#define LOGGER_HAS_STD_SOURCE_LOCATION 0
+#endif
+
+namespace logger {
+
+/**
+ * @brief Offset of the file name within `path` (one past the last separator)
+ */
+constexpr std::size_t BasenameOffset(const char *path) noexcept {
+    std::size_t offset = 0;
+    for (std::size_t i = 0; path[i] != '\0'; ++i) {
+        if (path[i] == '/' || path[i] == '\\') {
+            offset = i + 1;
+        }
+    }
+    return offset;
+}
+
+/**
+ * @brief `path` without its directories; constexpr, points into `path`
+ */
+constexpr const char *Basename(const char *path) noexcept {
+    return path + BasenameOffset(path);
+}
+
+/**
+ * @brief File, line and function of a call site
+ *
+ * `file` and `function` point to static storage, like the record fields
+ * they are copied into.
+ */
+struct SourceLocation {
+    const char *file;
+    int line;
+    const char *function;
+
+#if LOGGER_HAS_STD_SOURCE_LOCATION
+    /**
+     * @brief The caller's location, with the directories stripped
+     *
+     * constexpr rather than consteval: before C++23 (CWG 2631) an immediate
+     * invocation in a default argument is evaluated where the default is
+     * written, so a consteval Current() would report the wrapper's own
+     * declaration. file_name() is a literal, so optimizing builds still fold
+     * the scan to a constant; LLL_HERE guarantees it in every build.
+     *
+     * `function` is std::source_location::function_name(), which on GCC and
+     * Clang is the full signature rather than the bare __func__ name.
+     */
+    static constexpr SourceLocation Current(std::source_location here = std::source_location::current()) noexcept {
+        return SourceLocation{Basename(here.file_name()), static_cast<int>(here.line()), here.function_name()};
+    }
+#endif
+};
+
+} // namespace logger
+
+/**
+ * @brief __FILE__ without its directories, resolved at compile time
+ *
+ * The integral_constant forces the scan into constant evaluation even in
+ * unoptimized builds; the expression is a literal plus a constant.
+ */
+#define LLL_FILE_NAME (__FILE__ + std::integral_constant<std::size_t, ::logger::BasenameOffset(__FILE__)>::value)
+
+/**
+ * @brief SourceLocation of the line it appears on
+ *
+ * Example:
+ *   log.Log(logger::Level::Info, "order accepted", LLL_HERE);
+ */
+#define LLL_HERE (::logger::SourceLocation{LLL_FILE_NAME, __LINE__, __func__})
+
+#endif // LOGGER_SOURCE_LOCATION_H
@@ -0,0 +1,88 @@
+/**
+ * @file static_string.h
+ * @brief Zero-copy capture of string literals
+ *
+ * Defines StaticString, a pointer and length that is known to refer to a
+ * string literal, and the only two ways to make one: the `_lll` literal
+ * suffix and LLL_STATIC. Both accept nothing but a literal, so a
+ * StaticString always points to storage that lives for the whole process.
+ *
+ * Logger::Log(level, StaticString) stores the pointer and length in the
+ * record (RecordKind::Literal) instead of copying the text; the consumer
+ * reads the text through the pointer when it formats the record. Text that
+ * may change or go away (std::string, stack buffers) is passed as
+ * `const char *` or std::string_view and copied into the record.
+ *
+ * RESPONSIBILITIES:
+ * - Tell literals apart from transient text at compile time
+ *
+ * ANTI-RESPONSIBILITIES:
+ * - No copying, no length limit (a literal is never truncated)
+ * - No support for other static-storage strings (not provable at compile time)
+ */
+
+#ifndef LOGGER_STATIC_STRING_H
+#define LOGGER_STATIC_STRING_H
+
+#include <cstddef>
+
+namespace logger {
+
+class StaticString;
+
+namespace literals {
+
+constexpr StaticString operator""_lll(const char *text, std::size_t length) noexcept;
+
+} // namespace literals
+
+/**
+ * @brief A string literal: pointer and length, no copy
+ */
+class StaticString {
+  public:
+    constexpr const char *data() const noexcept {
+        return data_;
+    }
+
+    constexpr std::size_t size() const noexcept {
+        return size_;
+    }
+
+  private:
+    friend constexpr StaticString literals::operator""_lll(const char *text, std::size_t length) noexcept;
+
+    constexpr StaticString(const char *text, std::size_t length) noexcept : data_(text), size_(length) {}
+
+    const char *data_;
+    std::size_t size_;
+};
+
+namespace literals {
+
+/**
+ * @brief "text"_lll: a StaticString for a string literal
+ *
+ * Example:
+ *   using namespace logger::literals;
+ *   log.Info("order accepted"_lll);
+ */
+constexpr StaticString operator""_lll(const char *text, std::size_t length) noexcept {
+    return StaticString(text, length);
+}
+
+} // namespace literals
+
+} // namespace logger
+
+/**
+ * @brief StaticString for a string literal, without a using-directive
+ *
+ * `"" literal` only compiles for a literal, so a pointer variable is rejected.
+ *
+ * Example:
+ *   log.Info(LLL_STATIC("order accepted"));
+ */
+#define LLL_STATIC(literal) (::logger::literals::operator""_lll("" literal, sizeof("" literal) - 1))
+
+#endif // LOGGER_STATIC_STRING_H
@@ -0,0 +1,92 @@
+/**
+ * @file block_codec.h
+ * @brief Self-contained block compression for log output
+ *
+ * Provides an LZ4-compatible block codec (no external dependency); the
+ * compressed file format's little-endian fields use endian.h.
+ * Optional zstd support is compiled in when LOGGER_HAVE_ZSTD is defined.
+ *
+ * Each block is compressed independently, so any block can be decoded
+ * without reading the ones before it.
+ */
+
+#ifndef LOGGER_INTERNAL_BLOCK_CODEC_H
+#define LOGGER_INTERNAL_BLOCK_CODEC_H
+
+#include "endian.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace logger {
+namespace internal {
+
+/**
+ * @brief Codec identifiers stored in each block header
+ */
+enum class BlockCodec : std::uint8_t {
+    Stored = 0, // Raw bytes (used when compression does not shrink the block)
+    Lz4 = 1,    // Built-in LZ4 block format
+    Zstd = 2    // zstd frame (requires LOGGER_HAVE_ZSTD)
+};
+
+// Hash table used by the LZ4 match finder (4 KB entries).
+inline constexpr std::size_t kLz4HashLog = 12;
+inline constexpr std::size_t kLz4HashSize = std::size_t{1} << kLz4HashLog;
+
+/**
+ * @brief Worst-case compressed size for `len` input bytes
+ */
+constexpr std::size_t Lz4CompressBound(std::size_t len) noexcept {
+    return len + (len / 255) + 16;
+}
+
+/**
+ * @brief Compress one block in LZ4 block format
+ * @param src Input bytes
+ * @param src_len Number of input bytes
+ * @param dst Output buffer
+ * @param dst_capacity Size of the output buffer
+ * @param hash_table Scratch table of kLz4HashSize entries (caller owned, no allocation)
+ * @return Compressed size, or 0 if the output does not fit
+ */
+std::size_t Lz4Compress(const char *src, std::size_t src_len, char *dst, std::size_t dst_capacity,
+                        std::uint32_t *hash_table) noexcept;
+
+/**
+ * @brief Decompress one LZ4 block
+ * @param src Compressed bytes
+ * @param src_len Number of compressed bytes
+ * @param dst Output buffer
+ * @param dst_capacity Size of the output buffer
+ * @return Decompressed size, or 0 on malformed input / insufficient space
+ */
+std::size_t Lz4Decompress(const char *src, std::size_t src_len, char *dst, std::size_t dst_capacity) noexcept;
+
+/**
+ * @brief Whether the zstd codec was compiled in
+ */
+bool ZstdAvailable() noexcept;
+
+/**
+ * @brief Worst-case zstd output size (0 when zstd is not compiled in)
+ */
+std::size_t ZstdCompressBound(std::size_t len) noexcept;
+
+/**
+ * @brief Compress one block with zstd
+ * @return Compressed size, or 0 on failure / zstd unavailable
+ */
+std::size_t ZstdCompress(const char *src, std::size_t src_len, char *dst, std::size_t dst_capacity, int level) noexcept;
+
+/**
+ * @brief Decompress one zstd block
+ * @return Decompressed size, or 0 on failure / zstd unavailable
+ */
+std::size_t ZstdDecompress(const char *src, std::size_t src_len, char *dst, std::size_t dst_capacity) noexcept;
+
+} // namespace internal
+} // namespace logger
+
+#endif // LOGGER_INTERNAL_BLOCK_CODEC_H
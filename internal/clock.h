@@ -18,6 +18,21 @@ namespace internal {
  */
 std::uint64_t TscToNanoseconds(std::uint64_t tsc) noexcept;
 
+/**
+ * @brief TSC ticks per nanosecond used by TscToNanoseconds (calibrated on first use)
+ *
+ * Stored in binary log headers so offline tools can convert timestamps.
+ */
+double TscTicksPerNanosecond() noexcept;
+
+/**
+ * @brief Convert nanoseconds to TSC ticks (inverse of TscToNanoseconds)
+ *
+ * Lets producers compare raw TSC deltas against a duration without
+ * converting every measurement; compute once, outside the hot path.
+ */
+std::uint64_t NanosecondsToTsc(std::uint64_t ns) noexcept;
+
 } // namespace internal
 } // namespace logger
 
@@ -0,0 +1,48 @@
+/**
+ * @file endian.h
+ * @brief Little-endian field helpers for on-disk and in-record formats
+ *
+ * File formats (compressed, binary) and the packed record header store
+ * integers little-endian regardless of the host. Byte-wise shifts compile
+ * to single loads/stores on little-endian targets.
+ *
+ * RESPONSIBILITIES:
+ * - Store/load 32- and 64-bit little-endian values at any alignment
+ *
+ * ANTI-RESPONSIBILITIES:
+ * - No format knowledge (callers own the layouts)
+ */
+
+#ifndef LOGGER_INTERNAL_ENDIAN_H
+#define LOGGER_INTERNAL_ENDIAN_H
+
+#include <cstdint>
+
+namespace logger {
+namespace internal {
+
+inline void StoreLe32(unsigned char *p, std::uint32_t v) noexcept {
+    p[0] = static_cast<unsigned char>(v);
+    p[1] = static_cast<unsigned char>(v >> 8);
+    p[2] = static_cast<unsigned char>(v >> 16);
+    p[3] = static_cast<unsigned char>(v >> 24);
+}
+
+inline void StoreLe64(unsigned char *p, std::uint64_t v) noexcept {
+    StoreLe32(p, static_cast<std::uint32_t>(v));
+    StoreLe32(p + 4, static_cast<std::uint32_t>(v >> 32));
+}
+
+inline std::uint32_t LoadLe32(const unsigned char *p) noexcept {
+    return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8) |
+           (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+inline std::uint64_t LoadLe64(const unsigned char *p) noexcept {
+    return static_cast<std::uint64_t>(LoadLe32(p)) | (static_cast<std::uint64_t>(LoadLe32(p + 4)) << 32);
+}
+
+} // namespace internal
+} // namespace logger
+
+#endif // LOGGER_INTERNAL_ENDIAN_H
@@ -0,0 +1,95 @@
+/**
+ * @file nontemporal.h
+ * @brief Cache-bypassing (non-temporal) block copies
+ *
+ * A producer that writes a ring slot never reads it again; a normal store
+ * still allocates the slot's lines in the producer's L1/L2 and evicts the
+ * producer's own working set. Non-temporal stores go through write-combining
+ * buffers straight towards memory instead.
+ *
+ * Non-temporal stores are weakly ordered: StreamFence() must run before the
+ * store that publishes the data to another thread.
+ *
+ * RESPONSIBILITIES:
+ * - StreamCopy / StreamFence for x86 (SSE2 movntdq, AVX vmovntdq) and ARM64 (stnp)
+ * - A plain memcpy / no-op fallback elsewhere (LOGGER_HAS_NONTEMPORAL == 0)
+ *
+ * ANTI-RESPONSIBILITIES:
+ * - No policy (the ring decides when to use it, see LOGGER_RING_NONTEMPORAL)
+ */
+
+#ifndef LOGGER_INTERNAL_NONTEMPORAL_H
+#define LOGGER_INTERNAL_NONTEMPORAL_H
+
+#include "platform.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if (defined(LOGGER_ARCH_X64) || defined(LOGGER_ARCH_X86)) && (defined(__SSE2__) || defined(_M_X64))
+#define LOGGER_HAS_NONTEMPORAL 1
+#include <immintrin.h>
+#elif defined(LOGGER_ARCH_ARM64) && defined(LOGGER_COMPILER_GCC_COMPATIBLE)
+#define LOGGER_HAS_NONTEMPORAL 1
+#else
+#define LOGGER_HAS_NONTEMPORAL 0
+#endif
+
+namespace logger {
+namespace internal {
+
+/**
+ * @brief Copy `bytes` from `src` to `dst` without allocating `dst` in the cache
+ *
+ * @param dst Destination, 16-byte aligned (32 for the AVX path to use full vectors)
+ * @param src Source, any alignment
+ * @param bytes Multiple of 16
+ */
+inline void StreamCopy(void *dst, const void *src, std::size_t bytes) noexcept {
+#if LOGGER_HAS_NONTEMPORAL && (defined(LOGGER_ARCH_X64) || defined(LOGGER_ARCH_X86))
+    char *out = static_cast<char *>(dst);
+    const char *in = static_cast<const char *>(src);
+    std::size_t offset = 0;
+#if defined(__AVX__)
+    if ((reinterpret_cast<std::uintptr_t>(out) & 31) == 0) {
+        for (; offset + 32 <= bytes; offset += 32) {
+            const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + offset));
+            _mm256_stream_si256(reinterpret_cast<__m256i *>(out + offset), chunk);
+        }
+    }
+#endif
+    for (; offset < bytes; offset += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + offset));
+        _mm_stream_si128(reinterpret_cast<__m128i *>(out + offset), chunk);
+    }
+#elif LOGGER_HAS_NONTEMPORAL
+    char *out = static_cast<char *>(dst);
+    const char *in = static_cast<const char *>(src);
+    for (std::size_t offset = 0; offset < bytes; offset += 16) {
+        std::uint64_t low;
+        std::uint64_t high;
+        std::memcpy(&low, in + offset, sizeof(low));
+        std::memcpy(&high, in + offset + 8, sizeof(high));
+        __asm__ volatile("stnp %x0, %x1, [%2]" : : "r"(low), "r"(high), "r"(out + offset) : "memory");
+    }
+#else
+    std::memcpy(dst, src, bytes);
+#endif
+}
+
+/**
+ * @brief Order earlier StreamCopy stores before any later store (e.g. a release publish)
+ */
+inline void StreamFence() noexcept {
+#if LOGGER_HAS_NONTEMPORAL && (defined(LOGGER_ARCH_X64) || defined(LOGGER_ARCH_X86))
+    _mm_sfence();
+#elif LOGGER_HAS_NONTEMPORAL
+    __asm__ volatile("dmb ishst" : : : "memory");
+#endif
+}
+
+} // namespace internal
+} // namespace logger
+
+#endif // LOGGER_INTERNAL_NONTEMPORAL_H
@@ -0,0 +1,343 @@
+#include "../include/backend.h"
+#include "../include/error.h"
+#include "../internal/platform.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace logger {
+
+namespace {
+
+// Marks a slot claimed by Register() but not yet published.
+Channel *const kReservedSlot = reinterpret_cast<Channel *>(alignof(Channel));
+
+bool IsLive(const Channel *channel) noexcept {
+    return channel != nullptr && channel != kReservedSlot;
+}
+
+} // namespace
+
+Backend::Backend(std::size_t shard_count, bool work_stealing) noexcept
+    : shard_count_(std::min<std::size_t>(std::max<std::size_t>(shard_count, 1), LOGGER_MAX_BACKEND_SHARDS)),
+      work_stealing_(work_stealing && shard_count_ > 1) {
+    if (shard_count != shard_count_) {
+        ReportError(ErrorCode::InvalidConfig, "Backend: shard count clamped to [1, LOGGER_MAX_BACKEND_SHARDS]");
+    }
+    for (std::size_t i = 0; i < shard_count_; ++i) {
+        shards_[i].index.shard = static_cast<std::uint32_t>(i);
+    }
+}
+
+Backend::~Backend() {
+    Stop();
+}
+
+bool Backend::SetShardDestination(std::size_t shard, Formatter &formatter, Sink &sink,
+                                  const FlushPolicy &flush_policy) noexcept {
+    if (IsRunning() || shard >= shard_count_) {
+        ReportError(ErrorCode::InvalidConfig, "Backend: shard output must be set before Start() on a valid shard");
+        return false;
+    }
+    Shard &target = shards_[shard];
+    target.router.reset(new Router(formatter, sink));
+    target.flush = FlushController(flush_policy);
+    target.output.router = target.router.get();
+    target.output.flush = &target.flush;
+    return true;
+}
+
+bool Backend::SetShardIndex(std::size_t shard, Sink &index_sink) noexcept {
+    if (IsRunning() || shard >= shard_count_ || !shards_[shard].router) {
+        ReportError(ErrorCode::InvalidConfig, "Backend: shard index needs a stopped backend and a shard output");
+        return false;
+    }
+    Shard &target = shards_[shard];
+    target.index.sink = &index_sink;
+    target.index.offset = 0;
+    target.output.index = &target.index;
+    return true;
+}
+
+void Backend::Start() {
+    bool expected = false;
+    if (is_running_.compare_exchange_strong(expected, true)) {
+        for (std::size_t i = 0; i < shard_count_; ++i) {
+            shards_[i].thread = std::thread(&Backend::Loop, this, static_cast<std::uint32_t>(i));
+        }
+    }
+}
+
+void Backend::Stop() {
+    bool expected = true;
+    if (is_running_.compare_exchange_strong(expected, false)) {
+        for (std::size_t i = 0; i < shard_count_; ++i) {
+            if (shards_[i].thread.joinable()) {
+                shards_[i].thread.join();
+            }
+        }
+    }
+}
+
+bool Backend::Register(Channel &channel, int shard) noexcept {
+    if (shard >= static_cast<int>(shard_count_)) {
+        ReportError(ErrorCode::InvalidConfig, "Backend: shard index out of range");
+        return false;
+    }
+    const std::uint32_t target =
+        shard >= 0 ? static_cast<std::uint32_t>(shard)
+                   : next_shard_.fetch_add(1, std::memory_order_relaxed) % static_cast<std::uint32_t>(shard_count_);
+    if (channel.SharesOutput() && !shards_[target].router) {
+        ReportError(ErrorCode::InvalidConfig, "Backend: logger without sinks on a shard without output");
+        return false;
+    }
+
+    for (std::size_t i = 0; i < LOGGER_MAX_BACKEND_CHANNELS; ++i) {
+        Slot &slot = slots_[i];
+        Channel *empty = nullptr;
+        if (slot.channel.compare_exchange_strong(empty, kReservedSlot, std::memory_order_relaxed)) {
+            slot.shard.store(target, std::memory_order_relaxed);
+            channel.lane_ = static_cast<std::uint32_t>(i);
+            // Publishes the shard and the fully constructed channel to the shard thread.
+            slot.channel.store(&channel, std::memory_order_seq_cst);
+            return true;
+        }
+    }
+    ReportError(ErrorCode::InvalidConfig, "Backend: no free channel slot (LOGGER_MAX_BACKEND_CHANNELS)");
+    return false;
+}
+
+void Backend::Unregister(Channel &channel) noexcept {
+    Slot *slot = nullptr;
+    for (Slot &candidate : slots_) {
+        if (candidate.channel.load(std::memory_order_relaxed) == &channel) {
+            slot = &candidate;
+            break;
+        }
+    }
+    if (!slot) {
+        return;
+    }
+    Shard &shard = shards_[slot->shard.load(std::memory_order_relaxed)];
+
+    // Only the shard thread may write to a shard output while it runs: let it drain the channel.
+    if (channel.SharesOutput()) {
+        while (IsRunning() && channel.Backlog() > 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    slot->channel.store(nullptr, std::memory_order_seq_cst);
+    // A pass that started after the slot was cleared cannot see the channel;
+    // wait out the ones that may be in flight.
+    for (std::size_t i = 0; i < shard_count_; ++i) {
+        const std::uint64_t seq = shards_[i].pass_seq.load(std::memory_order_seq_cst);
+        if (seq & 1) {
+            while (shards_[i].pass_seq.load(std::memory_order_acquire) == seq) {
+                LOGGER_CPU_RELAX();
+            }
+        }
+    }
+
+    if (channel.SharesOutput() && !IsRunning()) {
+        char scratch_buffer[kFormatScratchSize];
+        while (channel.Drain(scratch_buffer, sizeof(scratch_buffer), LOGGER_BACKEND_PASS_BUDGET, shard.output) > 0) {
+        }
+        shard.output.FlushSinks();
+    }
+}
+
+ShardStats Backend::GetShardStats(std::size_t shard) const noexcept {
+    if (shard >= shard_count_) {
+        return ShardStats{};
+    }
+    const Shard &target = shards_[shard];
+    return ShardStats{
+        target.records.load(std::memory_order_relaxed),
+        target.steals.load(std::memory_order_relaxed),
+        target.stolen_records.load(std::memory_order_relaxed),
+    };
+}
+
+std::size_t Backend::ChannelCount() const noexcept {
+    std::size_t count = 0;
+    for (const Slot &slot : slots_) {
+        if (IsLive(slot.channel.load(std::memory_order_relaxed))) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+std::size_t Backend::RunPass(Shard &shard, std::uint32_t shard_id, char *scratch, std::size_t capacity) {
+    Channel *channels[LOGGER_MAX_BACKEND_CHANNELS];
+    Slot *owned[LOGGER_MAX_BACKEND_CHANNELS];
+    std::size_t backlogs[LOGGER_MAX_BACKEND_CHANNELS];
+    std::size_t count = 0;
+    std::size_t total = 0;
+
+    shard.pass_seq.fetch_add(1, std::memory_order_seq_cst); // odd: in a pass
+    for (Slot &slot : slots_) {
+        Channel *channel = slot.channel.load(std::memory_order_seq_cst);
+        if (IsLive(channel) && slot.shard.load(std::memory_order_relaxed) == shard_id) {
+            channels[count] = channel;
+            owned[count] = &slot;
+            backlogs[count] = channel->Backlog();
+            total += backlogs[count];
+            ++count;
+        }
+    }
+
+    std::size_t processed = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        // The snapshot stays valid until the pass ends, even if the slot is cleared meanwhile.
+        Channel &channel = *channels[i];
+        if (backlogs[i] == 0 && channel.SharesOutput() && !channel.HistogramsDue()) {
+            continue;
+        }
+        if (!AcquireToken(*owned[i], shard_id)) {
+            continue; // a peer is stealing a batch; it releases the token when done
+        }
+        processed += channel.PollHistograms(scratch, capacity, OutputFor(channel, shard));
+        if (backlogs[i] == 0) {
+            channel.OnIdle();
+        } else {
+            // Share of the pass budget proportional to backlog; at least one record
+            // so a quiet logger is never starved by a noisy one.
+            const std::size_t share = backlogs[i] * LOGGER_BACKEND_PASS_BUDGET / total;
+            const std::size_t budget = std::min(backlogs[i], std::max<std::size_t>(share, 1));
+            processed += channel.Drain(scratch, capacity, budget, OutputFor(channel, shard));
+        }
+        ReleaseToken(*owned[i]);
+    }
+    if (processed == 0 && work_stealing_) {
+        processed = Steal(shard, shard_id, scratch, capacity);
+    }
+    shard.pass_seq.fetch_add(1, std::memory_order_release); // even: between passes
+
+    if (processed > 0) {
+        shard.records.store(shard.records.load(std::memory_order_relaxed) + processed, std::memory_order_relaxed);
+    }
+
+    if (processed == 0 && shard.router) {
+        shard.output.OnIdle();
+    }
+    return processed;
+}
+
+std::size_t Backend::Steal(Shard &shard, std::uint32_t shard_id, char *scratch, std::size_t capacity) {
+    // Victim: the most backlogged channel of another shard, if it is worth a batch.
+    Slot *victim = nullptr;
+    Channel *victim_channel = nullptr;
+    std::size_t victim_backlog = LOGGER_BACKEND_STEAL_MIN_BACKLOG - 1;
+    for (Slot &slot : slots_) {
+        Channel *channel = slot.channel.load(std::memory_order_seq_cst);
+        if (!IsLive(channel) || slot.shard.load(std::memory_order_relaxed) == shard_id) {
+            continue;
+        }
+        if (channel->SharesOutput() && !shard.router) {
+            continue; // nowhere to write it
+        }
+        const std::size_t backlog = channel->Backlog();
+        if (backlog > victim_backlog) {
+            victim = &slot;
+            victim_channel = channel;
+            victim_backlog = backlog;
+        }
+    }
+    if (!victim || !AcquireToken(*victim, shard_id)) {
+        return 0;
+    }
+
+    // Holding the token makes this thread the ring's only consumer for one
+    // batch, so per-lane order is kept.
+    Channel &channel = *victim_channel;
+    const std::size_t stolen = channel.Drain(scratch, capacity, LOGGER_BACKEND_PASS_BUDGET, OutputFor(channel, shard));
+    ReleaseToken(*victim);
+
+    if (stolen > 0) {
+        shard.steals.store(shard.steals.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        shard.stolen_records.store(shard.stolen_records.load(std::memory_order_relaxed) + stolen,
+                                   std::memory_order_relaxed);
+    }
+    return stolen;
+}
+
+void Backend::Loop(std::uint32_t shard_id) {
+    Shard &shard = shards_[shard_id];
+    char scratch_buffer[kFormatScratchSize];
+    int idle_spins = 0;
+
+    while (is_running_.load(std::memory_order_relaxed)) {
+        if (RunPass(shard, shard_id, scratch_buffer, sizeof(scratch_buffer)) > 0) {
+            idle_spins = 0;
+            continue;
+        }
+        // Same hybrid wait as the Consumer: spin briefly, then sleep.
+        if (++idle_spins < LOGGER_BACKEND_SPIN_COUNT) {
+            LOGGER_CPU_RELAX();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+        }
+    }
+
+    // Ensure everything is flushed before exit
+    shard.pass_seq.fetch_add(1, std::memory_order_seq_cst);
+    for (Slot &slot : slots_) {
+        Channel *channel = slot.channel.load(std::memory_order_seq_cst);
+        if (IsLive(channel) && slot.shard.load(std::memory_order_relaxed) == shard_id && !channel->SharesOutput()) {
+            while (!AcquireToken(slot, shard_id)) {
+                LOGGER_CPU_RELAX(); // a peer's last stolen batch
+            }
+            channel->FlushSinks();
+            ReleaseToken(slot);
+        }
+    }
+    shard.pass_seq.fetch_add(1, std::memory_order_release);
+    if (shard.router) {
+        shard.output.FlushSinks();
+    }
+}
+
+bool MergeShardIndexes(const char *const *index_paths, std::size_t count, const char *out_path) {
+    std::vector<IndexEntry> entries;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::FILE *file = index_paths[i] ? std::fopen(index_paths[i], "rb") : nullptr;
+        if (!file) {
+            ReportError(ErrorCode::FileOpenFailed, "MergeShardIndexes: cannot open index");
+            return false;
+        }
+        IndexEntry batch[1024];
+        std::size_t n;
+        while ((n = std::fread(batch, sizeof(IndexEntry), 1024, file)) > 0) {
+            entries.insert(entries.end(), batch, batch + n);
+        }
+        std::fclose(file);
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const IndexEntry &a, const IndexEntry &b) {
+        if (a.timestamp != b.timestamp) {
+            return a.timestamp < b.timestamp;
+        }
+        if (a.shard != b.shard) {
+            return a.shard < b.shard;
+        }
+        return a.offset < b.offset;
+    });
+
+    std::FILE *out = out_path ? std::fopen(out_path, "wb") : nullptr;
+    if (!out) {
+        ReportError(ErrorCode::FileOpenFailed, "MergeShardIndexes: cannot create output");
+        return false;
+    }
+    const bool ok = std::fwrite(entries.data(), sizeof(IndexEntry), entries.size(), out) == entries.size();
+    if (std::fclose(out) != 0 || !ok) {
+        ReportError(ErrorCode::WriteFailed, "MergeShardIndexes: write failed");
+        return false;
+    }
+    return true;
+}
+
+} // namespace logger
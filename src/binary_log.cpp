@@ -0,0 +1,480 @@
+#include "../include/binary_log.h"
+#include "../include/error.h"
+#include "../internal/clock.h"
+#include "../internal/endian.h"
+#include "../internal/platform.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+
+#if defined(LOGGER_OS_POSIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace logger {
+
+namespace {
+
+constexpr std::size_t kMinBlockSize = 4 * 1024;
+constexpr std::size_t kMaxBlockSize = 64 * 1024 * 1024;
+
+std::uint64_t DoubleBits(double value) noexcept {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double BitsDouble(std::uint64_t bits) noexcept {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+} // namespace
+
+std::size_t BinaryFormatter::FormatRecord(const LogRecord &record, char *buffer, std::size_t capacity) {
+    if (!buffer || capacity < kRecordHeaderSize) {
+        return 0;
+    }
+    std::size_t room = capacity - kRecordHeaderSize;
+
+    // Scope timers are stored as text: the reader has no TSC pair field.
+    char payload[kFormatScratchSize];
+    std::size_t payload_len = 0;
+    const char *payload_text = RecordPayload(record, payload, payload_len);
+
+    // Location: "file\0function\0", dropped if it does not fit next to the message.
+    std::size_t file_len = 0;
+    std::size_t function_len = 0;
+    std::int32_t line = 0;
+#if LOGGER_ENABLE_SOURCE_LOCATION
+    if (record.file && record.function) {
+        file_len = std::strlen(record.file);
+        function_len = std::strlen(record.function);
+        line = record.line;
+    }
+#endif
+    std::size_t location_len = file_len + function_len + 2;
+    if (file_len + function_len == 0 || location_len > 0xFFFF || location_len + payload_len > room) {
+        location_len = 0;
+    }
+    room -= location_len;
+    const std::size_t message_len = std::min(payload_len, room);
+
+    unsigned char *out = reinterpret_cast<unsigned char *>(buffer);
+    std::uint64_t thread_id = 0;
+#if LOGGER_ENABLE_THREAD_ID
+    thread_id = record.thread_id;
+#endif
+    internal::StoreLe64(out, record.timestamp);
+    internal::StoreLe64(out + 8, thread_id);
+    internal::StoreLe32(out + 16, static_cast<std::uint32_t>(message_len));
+    internal::StoreLe32(out + 20, record.sample_rate);
+    out[24] = LevelToInt(record.level);
+    out[25] = record.kind == RecordKind::Binary ? kFlagHexDump : 0;
+    out[26] = static_cast<unsigned char>(location_len);
+    out[27] = static_cast<unsigned char>(location_len >> 8);
+    internal::StoreLe32(out + 28, static_cast<std::uint32_t>(line));
+
+    char *p = buffer + kRecordHeaderSize;
+#if LOGGER_ENABLE_SOURCE_LOCATION
+    if (location_len > 0) {
+        std::memcpy(p, record.file, file_len + 1);
+        std::memcpy(p + file_len + 1, record.function, function_len + 1);
+        p += location_len;
+    }
+#endif
+    std::memcpy(p, payload_text, message_len);
+    return kRecordHeaderSize + location_len + message_len;
+}
+
+BinaryFileSink::BinaryFileSink(const char *path, std::size_t block_size) noexcept
+    : file_(path ? std::fopen(path, "wb") : nullptr),
+      block_size_(std::clamp(block_size, kMinBlockSize, kMaxBlockSize)),
+      current_{},
+      file_offset_(0) {
+    if (!file_) {
+        if (path) {
+            ReportError(ErrorCode::FileOpenFailed, "BinaryFileSink open failed");
+        }
+        return;
+    }
+    block_.reset(new char[block_size_]);
+    index_.reserve(1024);
+
+    // Anchor TSC to wall-clock time so tools can answer "between 14:31:02 and 14:31:05".
+    const std::uint64_t anchor_tsc = internal::ReadTsc();
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    const std::uint64_t anchor_unix_ns =
+        static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+
+    unsigned char header[kFileHeaderSize] = {};
+    internal::StoreLe32(header, kFileMagic);
+    header[4] = static_cast<unsigned char>(kVersion);
+    header[5] = static_cast<unsigned char>(kVersion >> 8);
+    internal::StoreLe32(header + 8, static_cast<std::uint32_t>(block_size_));
+    internal::StoreLe64(header + 16, DoubleBits(internal::TscTicksPerNanosecond()));
+    internal::StoreLe64(header + 24, anchor_tsc);
+    internal::StoreLe64(header + 32, anchor_unix_ns);
+    if (std::fwrite(header, 1, sizeof(header), file_) != sizeof(header)) {
+        ReportError(ErrorCode::WriteFailed, "BinaryFileSink header write failed");
+    }
+    file_offset_ = kFileHeaderSize;
+}
+
+BinaryFileSink::~BinaryFileSink() {
+    if (!file_) {
+        return;
+    }
+    CloseBlock();
+    WriteIndex();
+    std::fclose(file_);
+}
+
+void BinaryFileSink::Write(const char *data, std::size_t len) {
+    if (!file_ || !data || len < BinaryFormatter::kRecordHeaderSize) {
+        return;
+    }
+    // Records never straddle blocks; one larger than a block gets a block of its own.
+    if (current_.payload_len > 0 && current_.payload_len + len > block_size_) {
+        CloseBlock();
+    }
+
+    const unsigned char *header = reinterpret_cast<const unsigned char *>(data);
+    const std::uint64_t tsc = internal::LoadLe64(header);
+    if (current_.record_count == 0) {
+        current_.min_tsc = tsc;
+        current_.max_tsc = tsc;
+    } else {
+        current_.min_tsc = std::min(current_.min_tsc, tsc);
+        current_.max_tsc = std::max(current_.max_tsc, tsc);
+    }
+    current_.level_mask |= static_cast<std::uint8_t>(1u << (header[24] & 7u));
+    ++current_.record_count;
+
+    if (len > block_size_) {
+        // Written straight from the caller's buffer; the block buffer and index granularity stay as configured.
+        current_.payload_len = static_cast<std::uint32_t>(len);
+        WriteBlock(data);
+        return;
+    }
+    std::memcpy(block_.get() + current_.payload_len, data, len);
+    current_.payload_len += static_cast<std::uint32_t>(len);
+}
+
+void BinaryFileSink::Flush() {
+    if (!file_) {
+        return;
+    }
+    CloseBlock();
+    if (std::fflush(file_) != 0) {
+        ReportError(ErrorCode::FlushFailed, "BinaryFileSink flush failed");
+    }
+}
+
+void BinaryFileSink::CloseBlock() {
+    if (current_.payload_len == 0) {
+        return;
+    }
+    WriteBlock(block_.get());
+}
+
+void BinaryFileSink::WriteBlock(const char *payload) {
+    unsigned char header[kBlockHeaderSize] = {};
+    internal::StoreLe32(header, kBlockMagic);
+    internal::StoreLe32(header + 4, current_.payload_len);
+    internal::StoreLe32(header + 8, current_.record_count);
+    header[12] = current_.level_mask;
+    internal::StoreLe64(header + 16, current_.min_tsc);
+    internal::StoreLe64(header + 24, current_.max_tsc);
+
+    if (std::fwrite(header, 1, sizeof(header), file_) != sizeof(header) ||
+        std::fwrite(payload, 1, current_.payload_len, file_) != current_.payload_len) {
+        ReportError(ErrorCode::WriteFailed, "BinaryFileSink block write failed");
+    } else {
+        current_.file_offset = file_offset_;
+        index_.push_back(current_);
+        file_offset_ += kBlockHeaderSize + current_.payload_len;
+    }
+    current_ = BinaryBlockInfo{};
+}
+
+void BinaryFileSink::WriteIndex() {
+    const std::uint64_t index_offset = file_offset_;
+    unsigned char entry[kIndexEntrySize];
+    for (const BinaryBlockInfo &block : index_) {
+        std::memset(entry, 0, sizeof(entry));
+        internal::StoreLe64(entry, block.file_offset);
+        internal::StoreLe32(entry + 8, block.payload_len);
+        internal::StoreLe32(entry + 12, block.record_count);
+        entry[16] = block.level_mask;
+        internal::StoreLe64(entry + 20, block.min_tsc);
+        internal::StoreLe64(entry + 28, block.max_tsc);
+        if (std::fwrite(entry, 1, sizeof(entry), file_) != sizeof(entry)) {
+            ReportError(ErrorCode::WriteFailed, "BinaryFileSink index write failed");
+            return;
+        }
+    }
+
+    unsigned char footer[kFooterSize];
+    internal::StoreLe64(footer, index_offset);
+    internal::StoreLe64(footer + 8, index_.size());
+    internal::StoreLe32(footer + 16, kIndexMagic);
+    internal::StoreLe32(footer + 20, kVersion);
+    if (std::fwrite(footer, 1, sizeof(footer), file_) != sizeof(footer)) {
+        ReportError(ErrorCode::WriteFailed, "BinaryFileSink footer write failed");
+    }
+}
+
+BinaryLogReader::~BinaryLogReader() {
+#if defined(LOGGER_OS_POSIX)
+    if (mapped_) {
+        ::munmap(const_cast<unsigned char *>(data_), size_);
+    }
+#endif
+}
+
+bool BinaryLogReader::Open(const char *path) {
+    if (!path || data_) {
+        return false;
+    }
+#if defined(LOGGER_OS_POSIX)
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+    void *map = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        return false;
+    }
+    data_ = static_cast<const unsigned char *>(map);
+    mapped_ = true;
+#else
+    std::FILE *file = std::fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    std::fseek(file, 0, SEEK_END);
+    const long length = std::ftell(file);
+    std::fseek(file, 0, SEEK_SET);
+    if (length > 0) {
+        fallback_.resize(static_cast<std::size_t>(length));
+        fallback_.resize(std::fread(fallback_.data(), 1, fallback_.size(), file));
+    }
+    std::fclose(file);
+    data_ = fallback_.data();
+    size_ = fallback_.size();
+#endif
+
+    if (size_ < BinaryFileSink::kFileHeaderSize || internal::LoadLe32(data_) != BinaryFileSink::kFileMagic) {
+        return false;
+    }
+    ticks_per_ns_ = BitsDouble(internal::LoadLe64(data_ + 16));
+    if (!(ticks_per_ns_ > 0.0)) {
+        ticks_per_ns_ = 1.0;
+    }
+    anchor_tsc_ = internal::LoadLe64(data_ + 24);
+    anchor_unix_ns_ = internal::LoadLe64(data_ + 32);
+
+    footer_index_ = LoadFooterIndex();
+    if (!footer_index_ && !ScanBlocks()) {
+        return false;
+    }
+
+    // Monotone envelopes of the block bounds for FindBlocks().
+    const std::size_t count = blocks_.size();
+    max_prefix_.resize(count);
+    min_suffix_.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        max_prefix_[i] = i == 0 ? blocks_[i].max_tsc : std::max(max_prefix_[i - 1], blocks_[i].max_tsc);
+    }
+    for (std::size_t i = count; i > 0; --i) {
+        min_suffix_[i - 1] = i == count ? blocks_[i - 1].min_tsc : std::min(min_suffix_[i], blocks_[i - 1].min_tsc);
+    }
+    return true;
+}
+
+bool BinaryLogReader::LoadFooterIndex() {
+    if (size_ < BinaryFileSink::kFileHeaderSize + BinaryFileSink::kFooterSize) {
+        return false;
+    }
+    const unsigned char *footer = data_ + size_ - BinaryFileSink::kFooterSize;
+    if (internal::LoadLe32(footer + 16) != BinaryFileSink::kIndexMagic) {
+        return false;
+    }
+    const std::uint64_t index_offset = internal::LoadLe64(footer);
+    const std::uint64_t block_count = internal::LoadLe64(footer + 8);
+    if (index_offset > size_ || block_count > (size_ - index_offset) / BinaryFileSink::kIndexEntrySize) {
+        return false;
+    }
+
+    blocks_.clear();
+    blocks_.reserve(static_cast<std::size_t>(block_count));
+    const unsigned char *entry = data_ + index_offset;
+    for (std::uint64_t i = 0; i < block_count; ++i, entry += BinaryFileSink::kIndexEntrySize) {
+        BinaryBlockInfo block{internal::LoadLe64(entry), internal::LoadLe32(entry + 8), internal::LoadLe32(entry + 12),
+                              entry[16], internal::LoadLe64(entry + 20), internal::LoadLe64(entry + 28)};
+        // Untrusted offsets: compare without forming file_offset + length, which can wrap.
+        if (block.file_offset > index_offset ||
+            BinaryFileSink::kBlockHeaderSize + block.payload_len > index_offset - block.file_offset) {
+            blocks_.clear();
+            return false;
+        }
+        blocks_.push_back(block);
+    }
+    return true;
+}
+
+bool BinaryLogReader::ScanBlocks() {
+    // No footer: walk the self-describing block headers up to the first damaged one.
+    blocks_.clear();
+    std::size_t offset = BinaryFileSink::kFileHeaderSize;
+    while (offset + BinaryFileSink::kBlockHeaderSize <= size_) {
+        const unsigned char *header = data_ + offset;
+        if (internal::LoadLe32(header) != BinaryFileSink::kBlockMagic) {
+            break;
+        }
+        BinaryBlockInfo block{offset, internal::LoadLe32(header + 4), internal::LoadLe32(header + 8), header[12],
+                              internal::LoadLe64(header + 16), internal::LoadLe64(header + 24)};
+        if (block.payload_len > size_ - offset - BinaryFileSink::kBlockHeaderSize) {
+            break; // torn final block
+        }
+        blocks_.push_back(block);
+        offset += BinaryFileSink::kBlockHeaderSize + block.payload_len;
+    }
+    return true;
+}
+
+std::uint64_t BinaryLogReader::TscToUnixNs(std::uint64_t tsc) const noexcept {
+    // Scale only the (small) distance to the anchor so doubles keep nanosecond precision.
+    const std::int64_t delta_ticks = static_cast<std::int64_t>(tsc - anchor_tsc_);
+    const std::int64_t delta_ns = static_cast<std::int64_t>(static_cast<double>(delta_ticks) / ticks_per_ns_);
+    if (delta_ns < 0 && static_cast<std::uint64_t>(-delta_ns) > anchor_unix_ns_) {
+        return 0;
+    }
+    return anchor_unix_ns_ + static_cast<std::uint64_t>(delta_ns);
+}
+
+std::uint64_t BinaryLogReader::UnixNsToTsc(std::uint64_t unix_ns) const noexcept {
+    const double delta_ticks = static_cast<double>(static_cast<std::int64_t>(unix_ns - anchor_unix_ns_)) * ticks_per_ns_;
+    if (delta_ticks < 0.0 && -delta_ticks >= static_cast<double>(anchor_tsc_)) {
+        return 0;
+    }
+    if (delta_ticks >= static_cast<double>(~anchor_tsc_)) {
+        return ~std::uint64_t{0};
+    }
+    return anchor_tsc_ + static_cast<std::uint64_t>(static_cast<std::int64_t>(delta_ticks));
+}
+
+void BinaryLogReader::FindBlocks(std::uint64_t from_tsc, std::uint64_t to_tsc, std::size_t &first,
+                                 std::size_t &last) const noexcept {
+    // Blocks before `first` end before from_tsc; blocks from `last` on start after to_tsc.
+    first = static_cast<std::size_t>(std::lower_bound(max_prefix_.begin(), max_prefix_.end(), from_tsc) -
+                                     max_prefix_.begin());
+    last = static_cast<std::size_t>(std::upper_bound(min_suffix_.begin(), min_suffix_.end(), to_tsc) -
+                                    min_suffix_.begin());
+    if (last < first) {
+        last = first;
+    }
+}
+
+std::size_t BinaryLogReader::ParseRecord(const unsigned char *p, std::size_t available,
+                                         BinaryRecordView &record) noexcept {
+    if (available < BinaryFormatter::kRecordHeaderSize || p[24] >= kLevelCount) {
+        return 0;
+    }
+    const std::size_t message_len = internal::LoadLe32(p + 16);
+    const std::size_t location_len = static_cast<std::size_t>(p[26]) | (static_cast<std::size_t>(p[27]) << 8);
+    const std::size_t total = BinaryFormatter::kRecordHeaderSize + location_len + message_len;
+    if (total > available) {
+        return 0;
+    }
+
+    record.timestamp = internal::LoadLe64(p);
+    record.thread_id = internal::LoadLe64(p + 8);
+    record.sample_rate = internal::LoadLe32(p + 20);
+    record.level = static_cast<Level>(p[24]);
+    record.hex_dump = (p[25] & BinaryFormatter::kFlagHexDump) != 0;
+    record.line = static_cast<std::int32_t>(internal::LoadLe32(p + 28));
+    record.file = "";
+    record.function = "";
+    const char *location = reinterpret_cast<const char *>(p + BinaryFormatter::kRecordHeaderSize);
+    if (location_len > 0) {
+        const char *split = static_cast<const char *>(std::memchr(location, '\0', location_len));
+        if (!split || location[location_len - 1] != '\0') {
+            return 0;
+        }
+        record.file = location;
+        record.function = split + 1;
+    }
+    record.message = location + location_len;
+    record.message_length = message_len;
+    return total;
+}
+
+std::size_t BinaryLogReader::FormatText(const BinaryRecordView &record, char *buffer,
+                                        std::size_t capacity) const noexcept {
+    if (!buffer || capacity == 0) {
+        return 0;
+    }
+    if (record.hex_dump && record.message_length >= kBinaryChunkHeaderSize &&
+        internal::LoadLe32(reinterpret_cast<const unsigned char *>(record.message)) != 0) {
+        return FormatBinaryChunk(record.message, record.message_length, buffer, capacity); // continuation
+    }
+    const std::uint64_t unix_ns = TscToUnixNs(record.timestamp);
+    const std::time_t seconds = static_cast<std::time_t>(unix_ns / 1000000000ull);
+    std::tm utc{};
+#if defined(LOGGER_OS_WINDOWS)
+    gmtime_s(&utc, &seconds);
+#else
+    gmtime_r(&seconds, &utc);
+#endif
+
+    int written = std::snprintf(buffer, capacity, "[%04d-%02d-%02dT%02d:%02d:%02d.%09lluZ] [%s]", utc.tm_year + 1900,
+                                utc.tm_mon + 1, utc.tm_mday, utc.tm_hour, utc.tm_min, utc.tm_sec,
+                                static_cast<unsigned long long>(unix_ns % 1000000000ull),
+                                LevelToString(record.level));
+    std::size_t pos = written > 0 ? std::min(static_cast<std::size_t>(written), capacity - 1) : 0;
+    if (record.sample_rate > 1 && pos < capacity) {
+        written = std::snprintf(buffer + pos, capacity - pos, " [sample=1/%u]", static_cast<unsigned>(record.sample_rate));
+        pos += written > 0 ? std::min(static_cast<std::size_t>(written), capacity - 1 - pos) : 0;
+    }
+    if (pos < capacity) {
+        written = std::snprintf(buffer + pos, capacity - pos, " [tid=%llu]",
+                                static_cast<unsigned long long>(record.thread_id));
+        pos += written > 0 ? std::min(static_cast<std::size_t>(written), capacity - 1 - pos) : 0;
+    }
+    if (record.file[0] != '\0' && pos < capacity) {
+        written = std::snprintf(buffer + pos, capacity - pos, " %s:%d %s", record.file, record.line, record.function);
+        pos += written > 0 ? std::min(static_cast<std::size_t>(written), capacity - 1 - pos) : 0;
+    }
+    if (record.hex_dump && pos + 1 < capacity) {
+        buffer[pos++] = ' ';
+        return pos + FormatBinaryChunk(record.message, record.message_length, buffer + pos, capacity - pos);
+    }
+    if (pos + 1 < capacity) {
+        buffer[pos++] = ' ';
+        const std::size_t message_len = std::min(record.message_length, capacity - 1 - pos);
+        std::memcpy(buffer + pos, record.message, message_len);
+        pos += message_len;
+    }
+    if (pos < capacity - 1) {
+        buffer[pos++] = '\n';
+    }
+    buffer[pos] = '\0';
+    return pos;
+}
+
+} // namespace logger
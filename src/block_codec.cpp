@@ -0,0 +1,263 @@
+#include "../internal/block_codec.h"
+#include "../internal/platform.h"
+
+#include <cstring>
+
+#if defined(LOGGER_HAVE_ZSTD)
+#include <zstd.h>
+#endif
+
+namespace logger {
+namespace internal {
+
+namespace {
+
+// LZ4 block format constants.
+constexpr std::size_t kMinMatch = 4;
+constexpr std::size_t kLastLiterals = 5; // last 5 bytes are always literals
+constexpr std::size_t kMfLimit = 12;     // last match must start 12 bytes before the end
+constexpr std::size_t kMaxOffset = 65535;
+constexpr unsigned kSkipTrigger = 6; // speed up over incompressible data
+
+inline std::uint32_t Read32(const unsigned char *p) noexcept {
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline std::uint32_t Hash(std::uint32_t v) noexcept {
+    return (v * 2654435761u) >> (32 - kLz4HashLog);
+}
+
+// Write a length continuation (values >= 15 spill into 255-valued bytes).
+inline unsigned char *WriteLength(unsigned char *op, std::size_t len) noexcept {
+    while (len >= 255) {
+        *op++ = 255;
+        len -= 255;
+    }
+    *op++ = static_cast<unsigned char>(len);
+    return op;
+}
+
+} // namespace
+
+std::size_t Lz4Compress(const char *src, std::size_t src_len, char *dst, std::size_t dst_capacity,
+                        std::uint32_t *hash_table) noexcept {
+    if (!src || !dst || !hash_table || src_len == 0) {
+        return 0;
+    }
+
+    const unsigned char *const base = reinterpret_cast<const unsigned char *>(src);
+    const unsigned char *const iend = base + src_len;
+    const unsigned char *ip = base;
+    const unsigned char *anchor = base;
+    unsigned char *op = reinterpret_cast<unsigned char *>(dst);
+    unsigned char *const oend = op + dst_capacity;
+
+    if (src_len >= kMfLimit + 1) {
+        const unsigned char *const mflimit = iend - kMfLimit;
+        const unsigned char *const matchlimit = iend - kLastLiterals;
+
+        std::memset(hash_table, 0, kLz4HashSize * sizeof(std::uint32_t));
+        hash_table[Hash(Read32(ip))] = 0;
+        ++ip;
+
+        unsigned searches = 1u << kSkipTrigger;
+        while (ip < mflimit) {
+            const std::uint32_t sequence = Read32(ip);
+            const std::uint32_t h = Hash(sequence);
+            const unsigned char *ref = base + hash_table[h];
+            hash_table[h] = static_cast<std::uint32_t>(ip - base);
+
+            if (ref >= ip || static_cast<std::size_t>(ip - ref) > kMaxOffset || Read32(ref) != sequence) {
+                ip += (searches++ >> kSkipTrigger);
+                continue;
+            }
+            searches = 1u << kSkipTrigger;
+
+            // Extend backwards over literals that also match.
+            while (ip > anchor && ref > base && ip[-1] == ref[-1]) {
+                --ip;
+                --ref;
+            }
+
+            // Extend forwards, stopping before the trailing literals.
+            const unsigned char *mp = ip + kMinMatch;
+            const unsigned char *rp = ref + kMinMatch;
+            while (mp < matchlimit && *mp == *rp) {
+                ++mp;
+                ++rp;
+            }
+
+            const std::size_t literal_len = static_cast<std::size_t>(ip - anchor);
+            const std::size_t match_len = static_cast<std::size_t>(mp - ip) - kMinMatch;
+            const std::size_t worst = 1 + (literal_len / 255) + 1 + literal_len + 2 + (match_len / 255) + 1;
+            if (static_cast<std::size_t>(oend - op) < worst) {
+                return 0;
+            }
+
+            unsigned char *token = op++;
+            *token = 0;
+            if (literal_len >= 15) {
+                *token = 15 << 4;
+                op = WriteLength(op, literal_len - 15);
+            } else {
+                *token = static_cast<unsigned char>(literal_len << 4);
+            }
+            std::memcpy(op, anchor, literal_len);
+            op += literal_len;
+
+            const std::size_t offset = static_cast<std::size_t>(ip - ref);
+            *op++ = static_cast<unsigned char>(offset);
+            *op++ = static_cast<unsigned char>(offset >> 8);
+
+            if (match_len >= 15) {
+                *token |= 15;
+                op = WriteLength(op, match_len - 15);
+            } else {
+                *token |= static_cast<unsigned char>(match_len);
+            }
+
+            ip = mp;
+            anchor = ip;
+            if (ip < mflimit) {
+                // Index a position inside the match to improve the next search.
+                hash_table[Hash(Read32(ip - 2))] = static_cast<std::uint32_t>(ip - 2 - base);
+            }
+        }
+    }
+
+    // Trailing literals.
+    const std::size_t literal_len = static_cast<std::size_t>(iend - anchor);
+    if (static_cast<std::size_t>(oend - op) < 1 + (literal_len / 255) + 1 + literal_len) {
+        return 0;
+    }
+    if (literal_len >= 15) {
+        *op++ = 15 << 4;
+        op = WriteLength(op, literal_len - 15);
+    } else {
+        *op++ = static_cast<unsigned char>(literal_len << 4);
+    }
+    std::memcpy(op, anchor, literal_len);
+    op += literal_len;
+
+    return static_cast<std::size_t>(op - reinterpret_cast<unsigned char *>(dst));
+}
+
+std::size_t Lz4Decompress(const char *src, std::size_t src_len, char *dst, std::size_t dst_capacity) noexcept {
+    if (!src || !dst || src_len == 0) {
+        return 0;
+    }
+
+    const unsigned char *ip = reinterpret_cast<const unsigned char *>(src);
+    const unsigned char *const iend = ip + src_len;
+    unsigned char *const obase = reinterpret_cast<unsigned char *>(dst);
+    unsigned char *op = obase;
+    unsigned char *const oend = obase + dst_capacity;
+
+    // Read a length continuation; returns false on truncated input.
+    auto read_length = [&](std::size_t &len) -> bool {
+        unsigned char b;
+        do {
+            if (ip >= iend) {
+                return false;
+            }
+            b = *ip++;
+            len += b;
+        } while (b == 255);
+        return true;
+    };
+
+    while (ip < iend) {
+        const unsigned token = *ip++;
+
+        std::size_t literal_len = token >> 4;
+        if (literal_len == 15 && !read_length(literal_len)) {
+            return 0;
+        }
+        if (static_cast<std::size_t>(iend - ip) < literal_len || static_cast<std::size_t>(oend - op) < literal_len) {
+            return 0;
+        }
+        std::memcpy(op, ip, literal_len);
+        ip += literal_len;
+        op += literal_len;
+
+        if (ip == iend) {
+            break; // last sequence carries literals only
+        }
+
+        if (iend - ip < 2) {
+            return 0;
+        }
+        const std::size_t offset = static_cast<std::size_t>(ip[0]) | (static_cast<std::size_t>(ip[1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<std::size_t>(op - obase)) {
+            return 0;
+        }
+
+        std::size_t match_len = token & 15;
+        if (match_len == 15 && !read_length(match_len)) {
+            return 0;
+        }
+        match_len += kMinMatch;
+        if (static_cast<std::size_t>(oend - op) < match_len) {
+            return 0;
+        }
+
+        const unsigned char *match = op - offset;
+        if (offset >= match_len) {
+            std::memcpy(op, match, match_len);
+            op += match_len;
+        } else {
+            // Overlapping copy replicates the repeating pattern byte by byte.
+            for (std::size_t i = 0; i < match_len; ++i) {
+                *op++ = *match++;
+            }
+        }
+    }
+
+    return static_cast<std::size_t>(op - obase);
+}
+
+#if defined(LOGGER_HAVE_ZSTD)
+
+bool ZstdAvailable() noexcept {
+    return true;
+}
+
+std::size_t ZstdCompressBound(std::size_t len) noexcept {
+    return ZSTD_compressBound(len);
+}
+
+std::size_t ZstdCompress(const char *src, std::size_t src_len, char *dst, std::size_t dst_capacity, int level) noexcept {
+    const std::size_t result = ZSTD_compress(dst, dst_capacity, src, src_len, level);
+    return ZSTD_isError(result) ? 0 : result;
+}
+
+std::size_t ZstdDecompress(const char *src, std::size_t src_len, char *dst, std::size_t dst_capacity) noexcept {
+    const std::size_t result = ZSTD_decompress(dst, dst_capacity, src, src_len);
+    return ZSTD_isError(result) ? 0 : result;
+}
+
+#else
+
+bool ZstdAvailable() noexcept {
+    return false;
+}
+
+std::size_t ZstdCompressBound(std::size_t) noexcept {
+    return 0;
+}
+
+std::size_t ZstdCompress(const char *, std::size_t, char *, std::size_t, int) noexcept {
+    return 0;
+}
+
+std::size_t ZstdDecompress(const char *, std::size_t, char *, std::size_t) noexcept {
+    return 0;
+}
+
+#endif
+
+} // namespace internal
+} // namespace logger
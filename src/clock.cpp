@@ -6,7 +6,7 @@
 namespace logger {
 namespace internal {
 
-std::uint64_t TscToNanoseconds(std::uint64_t tsc) noexcept {
+double TscTicksPerNanosecond() noexcept {
     struct Calibration {
         double ticks_per_ns;
     };
@@ -35,10 +35,19 @@ std::uint64_t TscToNanoseconds(std::uint64_t tsc) noexcept {
         return Calibration{ticks_per_ns};
     }();
 
-    if (calibration.ticks_per_ns <= 0.0) {
+    return calibration.ticks_per_ns;
+}
+
+std::uint64_t TscToNanoseconds(std::uint64_t tsc) noexcept {
+    const double ticks_per_ns = TscTicksPerNanosecond();
+    if (ticks_per_ns <= 0.0) {
         return 0;
     }
-    return static_cast<std::uint64_t>(static_cast<double>(tsc) / calibration.ticks_per_ns);
+    return static_cast<std::uint64_t>(static_cast<double>(tsc) / ticks_per_ns);
+}
+
+std::uint64_t NanosecondsToTsc(std::uint64_t ns) noexcept {
+    return static_cast<std::uint64_t>(static_cast<double>(ns) * TscTicksPerNanosecond());
 }
 
 } // namespace internal
@@ -0,0 +1,381 @@
+#include "../include/compressed_sink.h"
+#include "../include/config.h"
+#include "../include/error.h"
+#include "../internal/endian.h"
+#include "../internal/platform.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace logger {
+
+namespace {
+
+constexpr std::size_t kMinBlockSize = 4 * 1024;
+constexpr std::size_t kMaxBlockSize = 64 * 1024 * 1024;
+
+} // namespace
+
+CompressedFileSink::CompressedFileSink(const char *path, const CompressedSinkOptions &options) noexcept
+    : file_(path ? std::fopen(path, "wb") : nullptr),
+      options_(options),
+      compressed_capacity_(0),
+      blocks_{},
+      current_(-1),
+      file_offset_(0),
+      raw_offset_(0) {
+    if (!file_) {
+        if (path) {
+            ReportError(ErrorCode::FileOpenFailed, "CompressedFileSink open failed");
+        }
+        return;
+    }
+
+    options_.block_size = std::clamp(options_.block_size, kMinBlockSize, kMaxBlockSize);
+    options_.block_count = std::clamp<std::size_t>(options_.block_count, 2, kMaxBlocksInFlight);
+    if (options_.codec == internal::BlockCodec::Zstd && !internal::ZstdAvailable()) {
+        options_.codec = internal::BlockCodec::Lz4;
+    }
+
+    // All buffers are allocated once, here; steady state never allocates
+    // except for index growth on the helper thread.
+    block_storage_.reset(new char[options_.block_size * options_.block_count]);
+    compressed_capacity_ = std::max(internal::Lz4CompressBound(options_.block_size),
+                                    internal::ZstdCompressBound(options_.block_size));
+    compressed_.reset(new char[compressed_capacity_]);
+    hash_table_.reset(new std::uint32_t[internal::kLz4HashSize]);
+    index_.reserve(1024);
+
+    for (std::size_t i = 0; i < options_.block_count; ++i) {
+        blocks_[i].data = block_storage_.get() + i * options_.block_size;
+        blocks_[i].size = 0;
+        (void)free_.TryPush(static_cast<std::uint32_t>(i));
+    }
+
+    unsigned char header[kFileHeaderSize] = {};
+    internal::StoreLe32(header, kFileMagic);
+    header[4] = static_cast<unsigned char>(kVersion);
+    header[5] = static_cast<unsigned char>(kVersion >> 8);
+    internal::StoreLe32(header + 8, static_cast<std::uint32_t>(options_.block_size));
+    if (std::fwrite(header, 1, sizeof(header), file_) != sizeof(header)) {
+        ReportError(ErrorCode::WriteFailed, "CompressedFileSink header write failed");
+    }
+    file_offset_ = kFileHeaderSize;
+
+    helper_ = std::thread(&CompressedFileSink::CompressLoop, this);
+}
+
+CompressedFileSink::~CompressedFileSink() {
+    if (!file_) {
+        return;
+    }
+    Submit();
+    stopping_.store(true, std::memory_order_release);
+    if (helper_.joinable()) {
+        helper_.join();
+    }
+    WriteIndex();
+    std::fclose(file_);
+}
+
+void CompressedFileSink::Write(const char *data, std::size_t len) {
+    if (!file_ || !data || len == 0) {
+        return;
+    }
+    raw_bytes_.fetch_add(len, std::memory_order_relaxed);
+
+    while (len > 0) {
+        if (current_ < 0) {
+            AcquireBlock();
+        }
+        Block &block = blocks_[current_];
+        const std::size_t room = options_.block_size - block.size;
+
+        // Keep writes that fit in a block whole, so blocks start on line boundaries.
+        if (len > room && block.size > 0 && len <= options_.block_size) {
+            Submit();
+            continue;
+        }
+
+        const std::size_t chunk = std::min(len, room);
+        std::memcpy(block.data + block.size, data, chunk);
+        block.size += chunk;
+        data += chunk;
+        len -= chunk;
+
+        if (block.size == options_.block_size) {
+            Submit();
+        }
+    }
+}
+
+void CompressedFileSink::Flush() {
+    if (file_) {
+        Submit();
+    }
+}
+
+CompressionStats CompressedFileSink::Stats() const noexcept {
+    return CompressionStats{
+        raw_bytes_.load(std::memory_order_relaxed),
+        stored_bytes_.load(std::memory_order_relaxed),
+        blocks_written_.load(std::memory_order_relaxed),
+        compress_ns_.load(std::memory_order_relaxed),
+        consumer_waits_.load(std::memory_order_relaxed),
+    };
+}
+
+void CompressedFileSink::Submit() {
+    if (current_ < 0 || blocks_[current_].size == 0) {
+        return;
+    }
+    // filled_ holds more slots than there are blocks, so this never fails.
+    (void)filled_.TryPush(static_cast<std::uint32_t>(current_));
+    current_ = -1;
+}
+
+void CompressedFileSink::AcquireBlock() {
+    std::uint32_t id = 0;
+    if (!free_.TryPop(id)) {
+        // Every block is in flight: wait for the helper (consumer-side backpressure only).
+        consumer_waits_.fetch_add(1, std::memory_order_relaxed);
+        int spins = 0;
+        while (!free_.TryPop(id)) {
+            if (++spins < LOGGER_BACKEND_SPIN_COUNT) {
+                LOGGER_CPU_RELAX();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+    current_ = static_cast<int>(id);
+    blocks_[current_].size = 0;
+}
+
+void CompressedFileSink::CompressLoop() {
+    bool dirty = false;
+    int idle_spins = 0;
+    std::uint32_t id = 0;
+
+    for (;;) {
+        if (filled_.TryPop(id)) {
+            WriteBlock(blocks_[id]);
+            (void)free_.TryPush(id);
+            dirty = true;
+            idle_spins = 0;
+            continue;
+        }
+
+        if (stopping_.load(std::memory_order_acquire)) {
+            // Consumer submitted its last block before setting the flag.
+            while (filled_.TryPop(id)) {
+                WriteBlock(blocks_[id]);
+            }
+            break;
+        }
+
+        if (dirty) {
+            if (std::fflush(file_) != 0) {
+                ReportError(ErrorCode::FlushFailed, "CompressedFileSink flush failed");
+            }
+            dirty = false;
+        }
+
+        // Same hybrid wait as the consumer: spin briefly, then sleep.
+        if (++idle_spins < LOGGER_BACKEND_SPIN_COUNT) {
+            LOGGER_CPU_RELAX();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+        }
+    }
+}
+
+void CompressedFileSink::WriteBlock(const Block &block) {
+    const auto start = std::chrono::steady_clock::now();
+
+    internal::BlockCodec codec = options_.codec;
+    std::size_t stored_len = 0;
+    if (codec == internal::BlockCodec::Zstd) {
+        stored_len = internal::ZstdCompress(block.data, block.size, compressed_.get(), compressed_capacity_,
+                                            options_.zstd_level);
+    } else {
+        stored_len = internal::Lz4Compress(block.data, block.size, compressed_.get(), compressed_capacity_,
+                                           hash_table_.get());
+    }
+
+    const char *payload = compressed_.get();
+    if (stored_len == 0 || stored_len >= block.size) {
+        codec = internal::BlockCodec::Stored;
+        stored_len = block.size;
+        payload = block.data;
+    }
+
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    compress_ns_.fetch_add(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+                           std::memory_order_relaxed);
+
+    unsigned char header[kBlockHeaderSize] = {};
+    internal::StoreLe32(header, static_cast<std::uint32_t>(block.size));
+    internal::StoreLe32(header + 4, static_cast<std::uint32_t>(stored_len));
+    header[8] = static_cast<unsigned char>(codec);
+
+    if (std::fwrite(header, 1, sizeof(header), file_) != sizeof(header) ||
+        std::fwrite(payload, 1, stored_len, file_) != stored_len) {
+        ReportError(ErrorCode::WriteFailed, "CompressedFileSink block write failed");
+        // The block is lost and an unknown part of it reached the file: take the
+        // stream position from stdio so later index entries stay exact, or stop
+        // indexing (no trailer) if even that is unknown.
+        raw_offset_ += block.size;
+        const long position = index_valid_ ? std::ftell(file_) : -1;
+        if (position < 0) {
+            index_valid_ = false;
+        } else {
+            file_offset_ = static_cast<std::uint64_t>(position);
+        }
+        return;
+    }
+
+    if (index_valid_) {
+        index_.push_back(IndexEntry{file_offset_, raw_offset_, static_cast<std::uint32_t>(block.size),
+                                    static_cast<std::uint32_t>(stored_len)});
+    }
+    file_offset_ += kBlockHeaderSize + stored_len;
+    raw_offset_ += block.size;
+
+    stored_bytes_.fetch_add(stored_len, std::memory_order_relaxed);
+    blocks_written_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void CompressedFileSink::WriteIndex() {
+    if (!index_valid_) {
+        ReportError(ErrorCode::WriteFailed, "CompressedFileSink index skipped after a failed block write");
+        return;
+    }
+    const std::uint64_t index_offset = file_offset_;
+    unsigned char entry[kIndexEntrySize];
+    for (const IndexEntry &e : index_) {
+        internal::StoreLe64(entry, e.file_offset);
+        internal::StoreLe64(entry + 8, e.raw_offset);
+        internal::StoreLe32(entry + 16, e.raw_len);
+        internal::StoreLe32(entry + 20, e.stored_len);
+        if (std::fwrite(entry, 1, sizeof(entry), file_) != sizeof(entry)) {
+            ReportError(ErrorCode::WriteFailed, "CompressedFileSink index write failed");
+            return;
+        }
+    }
+
+    unsigned char footer[kFooterSize];
+    internal::StoreLe64(footer, index_offset);
+    internal::StoreLe64(footer + 8, index_.size());
+    internal::StoreLe32(footer + 16, kIndexMagic);
+    internal::StoreLe32(footer + 20, kVersion);
+    if (std::fwrite(footer, 1, sizeof(footer), file_) != sizeof(footer)) {
+        ReportError(ErrorCode::WriteFailed, "CompressedFileSink footer write failed");
+    }
+}
+
+CompressedFileReader::~CompressedFileReader() {
+    if (file_) {
+        std::fclose(file_);
+    }
+}
+
+bool CompressedFileReader::Open(const char *path) {
+    if (file_) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+    index_.clear();
+    file_ = path ? std::fopen(path, "rb") : nullptr;
+    if (!file_) {
+        return false;
+    }
+
+    unsigned char header[CompressedFileSink::kFileHeaderSize];
+    if (std::fread(header, 1, sizeof(header), file_) != sizeof(header) ||
+        internal::LoadLe32(header) != CompressedFileSink::kFileMagic) {
+        return false;
+    }
+    block_size_ = internal::LoadLe32(header + 8);
+
+    unsigned char footer[CompressedFileSink::kFooterSize];
+    if (std::fseek(file_, -static_cast<long>(sizeof(footer)), SEEK_END) != 0 ||
+        std::fread(footer, 1, sizeof(footer), file_) != sizeof(footer) ||
+        internal::LoadLe32(footer + 16) != CompressedFileSink::kIndexMagic) {
+        return false;
+    }
+    const long file_size = std::ftell(file_);
+    const std::uint64_t index_offset = internal::LoadLe64(footer);
+    const std::uint64_t block_count = internal::LoadLe64(footer + 8);
+
+    // Untrusted footer: bound it by the file before reserving anything from it.
+    if (file_size < static_cast<long>(CompressedFileSink::kFileHeaderSize + sizeof(footer))) {
+        return false;
+    }
+    const std::uint64_t index_end = static_cast<std::uint64_t>(file_size) - sizeof(footer);
+    if (index_offset < CompressedFileSink::kFileHeaderSize || index_offset > index_end ||
+        block_count > (index_end - index_offset) / CompressedFileSink::kIndexEntrySize) {
+        return false;
+    }
+    if (std::fseek(file_, static_cast<long>(index_offset), SEEK_SET) != 0) {
+        return false;
+    }
+    index_.reserve(static_cast<std::size_t>(block_count));
+    std::uint32_t max_stored = 0;
+    unsigned char entry[CompressedFileSink::kIndexEntrySize];
+    for (std::uint64_t i = 0; i < block_count; ++i) {
+        if (std::fread(entry, 1, sizeof(entry), file_) != sizeof(entry)) {
+            index_.clear();
+            return false;
+        }
+        IndexEntry e{internal::LoadLe64(entry), internal::LoadLe64(entry + 8), internal::LoadLe32(entry + 16),
+                     internal::LoadLe32(entry + 20)};
+        // Blocks lie between the file header and the index; compare without forming offset + length.
+        if (e.file_offset < CompressedFileSink::kFileHeaderSize || e.file_offset > index_offset ||
+            CompressedFileSink::kBlockHeaderSize + std::uint64_t{e.stored_len} > index_offset - e.file_offset) {
+            index_.clear();
+            return false;
+        }
+        max_stored = std::max(max_stored, e.stored_len);
+        index_.push_back(e);
+    }
+    stored_.resize(max_stored);
+    return true;
+}
+
+std::size_t CompressedFileReader::ReadBlock(std::size_t block, char *buffer, std::size_t capacity) {
+    if (!file_ || block >= index_.size() || !buffer) {
+        return 0;
+    }
+    const IndexEntry &e = index_[block];
+    if (capacity < e.raw_len) {
+        return 0;
+    }
+
+    unsigned char header[CompressedFileSink::kBlockHeaderSize];
+    if (std::fseek(file_, static_cast<long>(e.file_offset), SEEK_SET) != 0 ||
+        std::fread(header, 1, sizeof(header), file_) != sizeof(header) ||
+        internal::LoadLe32(header) != e.raw_len || internal::LoadLe32(header + 4) != e.stored_len) {
+        return 0;
+    }
+    if (std::fread(stored_.data(), 1, e.stored_len, file_) != e.stored_len) {
+        return 0;
+    }
+
+    switch (static_cast<internal::BlockCodec>(header[8])) {
+    case internal::BlockCodec::Stored:
+        if (e.stored_len > capacity) {
+            return 0;
+        }
+        std::memcpy(buffer, stored_.data(), e.stored_len);
+        return e.stored_len;
+    case internal::BlockCodec::Lz4:
+        return internal::Lz4Decompress(stored_.data(), e.stored_len, buffer, capacity);
+    case internal::BlockCodec::Zstd:
+        return internal::ZstdDecompress(stored_.data(), e.stored_len, buffer, capacity);
+    }
+    return 0;
+}
+
+} // namespace logger
@@ -46,6 +46,10 @@ std::size_t EncodeTextRecord(const LogRecord &record, char *buffer, std::size_t
                   static_cast<unsigned long long>(timestamp_ns),
                   LevelToString(record.level));
 
+    if (record.sample_rate > 1) {
+        (void)appendf(" [sample=1/%u]", static_cast<unsigned>(record.sample_rate));
+    }
+
 #if LOGGER_ENABLE_THREAD_ID
     (void)appendf(" [tid=%llu]",
                   static_cast<unsigned long long>(record.thread_id));
@@ -71,7 +75,7 @@ std::size_t EncodeTextRecord(const LogRecord &record, char *buffer, std::size_t
         if (msg_len > available) {
             msg_len = available;
         }
-        std::memcpy(buffer + pos, record.message, msg_len);
+        std::memcpy(buffer + pos, record.MessageData(), msg_len);
         pos += msg_len;
     }
 
@@ -2,76 +2,303 @@
 #include "../include/level.h"
 #include "../include/record.h"
 #include "../internal/clock.h"
-#include <cstdarg>
-#include <cstdio>
+#include "../internal/endian.h"
+#include "../internal/platform.h"
+#include <algorithm>
 #include <cstring>
 
+// x86-64 always has SSE2; the dump renderer converts 16 bytes per instruction sequence.
+#if defined(LOGGER_ARCH_X64) || (defined(LOGGER_ARCH_X86) && defined(__SSE2__))
+#define LOGGER_HEX_SSE2 1
+#include <emmintrin.h>
+#endif
+
 namespace logger {
 
-std::size_t TextFormatter::FormatRecord(const LogRecord &record, char *buffer, std::size_t capacity) {
-    if (!buffer || capacity == 0) {
-        return 0;
-    }
+namespace {
+
+// Appends into a caller buffer, truncating at capacity - 1 (room for the terminator).
+// Integers are rendered by hand: this runs once per record on the consumer
+// and for every record an offline decoder renders, where snprintf dominates.
+class LineWriter {
+  public:
+    LineWriter(char *buffer, std::size_t capacity) noexcept : buffer_(buffer), limit_(capacity - 1) {}
 
-    std::size_t pos = 0;
-    //
-    auto appendf = [&](const char *fmt, ...) -> bool {
-        if (pos >= capacity) {
-            return false;
+    void Append(const char *data, std::size_t len) noexcept {
+        if (len > limit_ - pos_) {
+            len = limit_ - pos_;
         }
-        va_list args;
-        va_start(args, fmt);
-        int written = std::vsnprintf(buffer + pos, capacity - pos, fmt, args);
-        va_end(args);
-        if (written < 0) {
-            buffer[pos] = '\0';
-            return false;
+        std::memcpy(buffer_ + pos_, data, len);
+        pos_ += len;
+    }
+
+    void Append(const char *text) noexcept {
+        Append(text, std::strlen(text));
+    }
+
+    void Append(char c) noexcept {
+        if (pos_ < limit_) {
+            buffer_[pos_++] = c;
         }
-        if (static_cast<std::size_t>(written) >= (capacity - pos)) {
-            pos = capacity - 1;
-            buffer[pos] = '\0';
-            return false;
+    }
+
+    void AppendU64(std::uint64_t value) noexcept {
+        char digits[20];
+        std::size_t n = sizeof(digits);
+        do {
+            digits[--n] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+        Append(digits + n, sizeof(digits) - n);
+    }
+
+    void AppendI32(std::int32_t value) noexcept {
+        if (value < 0) {
+            Append('-');
+            AppendU64(static_cast<std::uint64_t>(-static_cast<std::int64_t>(value)));
+        } else {
+            AppendU64(static_cast<std::uint64_t>(value));
         }
-        pos += static_cast<std::size_t>(written);
-        return true;
-    };
+    }
+
+    char *Cursor() noexcept {
+        return buffer_ + pos_;
+    }
 
-    const std::uint64_t timestamp_ns = internal::TscToNanoseconds(record.timestamp);
-    (void)appendf("[%llu] [%s]",
-                  static_cast<unsigned long long>(timestamp_ns),
-                  LevelToString(record.level));
+    std::size_t Room() const noexcept {
+        return limit_ - pos_;
+    }
 
-#if LOGGER_ENABLE_THREAD_ID
-    (void)appendf(" [tid=%llu]",
-                  static_cast<unsigned long long>(record.thread_id));
+    void Advance(std::size_t len) noexcept {
+        pos_ += len;
+    }
+
+    std::size_t Finish() noexcept {
+        buffer_[pos_] = '\0';
+        return pos_;
+    }
+
+  private:
+    char *buffer_;
+    std::size_t limit_;
+    std::size_t pos_ = 0;
+};
+
+constexpr char kHexDigits[] = "0123456789abcdef";
+
+// 16 bytes -> 32 lowercase hex digits.
+inline void HexEncode16(const unsigned char *in, char *out) noexcept {
+#if LOGGER_HEX_SSE2
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+    const __m128i low_nibble = _mm_set1_epi8(0x0F);
+    const auto to_hex = [](__m128i nibbles) {
+        // '0' + n, plus ('a' - '0' - 10) where n > 9.
+        const __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9)), _mm_set1_epi8('a' - '0' - 10));
+        return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), letter);
+    };
+    const __m128i high = to_hex(_mm_and_si128(_mm_srli_epi16(bytes, 4), low_nibble));
+    const __m128i low = to_hex(_mm_and_si128(bytes, low_nibble));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_unpacklo_epi8(high, low));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 16), _mm_unpackhi_epi8(high, low));
+#else
+    for (int i = 0; i < 16; ++i) {
+        out[2 * i] = kHexDigits[in[i] >> 4];
+        out[2 * i + 1] = kHexDigits[in[i] & 0x0F];
+    }
 #endif
+}
 
-#if LOGGER_ENABLE_SOURCE_LOCATION
-    if (record.file && record.function) {
-        (void)appendf(" %s:%d %s", record.file, record.line, record.function);
+// 16 bytes -> printable ASCII, '.' for everything else.
+inline void AsciiColumn16(const unsigned char *in, char *out) noexcept {
+#if LOGGER_HEX_SSE2
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+    // Signed compares: bytes >= 0x80 are negative and fail the first test.
+    const __m128i printable =
+        _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8(0x1F)), _mm_cmplt_epi8(bytes, _mm_set1_epi8(0x7F)));
+    const __m128i text = _mm_or_si128(_mm_and_si128(printable, bytes), _mm_andnot_si128(printable, _mm_set1_epi8('.')));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), text);
+#else
+    for (int i = 0; i < 16; ++i) {
+        out[i] = (in[i] >= 0x20 && in[i] < 0x7F) ? static_cast<char>(in[i]) : '.';
     }
 #endif
+}
 
-    if (pos < capacity - 1) {
-        buffer[pos++] = ' ';
+// One kHexDumpLineSize line for up to 16 bytes at payload offset `address`; returns its length.
+std::size_t WriteHexLine(char *out, const unsigned char *data, std::size_t count, std::uint32_t address) noexcept {
+    unsigned char tail[16] = {};
+    if (count < 16) {
+        std::memcpy(tail, data, count);
+        data = tail;
     }
+    char hex[32];
+    char ascii[16];
+    HexEncode16(data, hex);
+    AsciiColumn16(data, ascii);
 
-    std::size_t msg_len = record.message_length;
-    if (msg_len > 0 && pos < capacity - 1) {
-        std::size_t available = capacity - 1 - pos;
-        if (msg_len > available) {
-            msg_len = available;
+    char *p = out;
+    *p++ = ' ';
+    *p++ = ' ';
+    for (int shift = 28; shift >= 0; shift -= 4) {
+        *p++ = kHexDigits[(address >> shift) & 0x0F];
+    }
+    *p++ = ':';
+    *p++ = ' ';
+    char *groups = p;
+    for (int group = 0; group < 8; ++group) {
+        std::memcpy(p, hex + 4 * group, 4);
+        p[4] = ' ';
+        p += 5;
+    }
+    for (std::size_t i = count; i < 16; ++i) {
+        std::memcpy(groups + (i / 2) * 5 + (i % 2) * 2, "  ", 2); // short last line
+    }
+    *p++ = ' ';
+    std::memcpy(p, ascii, count);
+    p += count;
+    *p++ = '\n';
+    return static_cast<std::size_t>(p - out);
+}
+
+} // namespace
+
+std::size_t FormatBinaryChunk(const char *chunk, std::size_t length, char *buffer, std::size_t capacity) noexcept {
+    if (!buffer || capacity == 0) {
+        return 0;
+    }
+    LineWriter out(buffer, capacity);
+    const char *label = chunk ? chunk + kBinaryChunkHeaderSize : nullptr;
+    const char *label_end =
+        label && length > kBinaryChunkHeaderSize
+            ? static_cast<const char *>(std::memchr(label, '\0', length - kBinaryChunkHeaderSize))
+            : nullptr;
+    if (!label_end) {
+        out.Append("<malformed binary payload>\n");
+        return out.Finish();
+    }
+    const unsigned char *header = reinterpret_cast<const unsigned char *>(chunk);
+    const std::uint32_t offset = internal::LoadLe32(header);
+    const std::uint32_t total = internal::LoadLe32(header + 4);
+    const unsigned char *data = reinterpret_cast<const unsigned char *>(label_end + 1);
+    const std::size_t data_length = static_cast<std::size_t>(chunk + length - (label_end + 1));
+
+    if (offset == 0) {
+        if (label_end != label) {
+            out.Append(label, static_cast<std::size_t>(label_end - label));
+            out.Append(' ');
         }
-        std::memcpy(buffer + pos, record.message, msg_len);
-        pos += msg_len;
+        out.Append('(');
+        out.AppendU64(total);
+        out.Append(" bytes)\n", 8);
+    }
+    for (std::size_t i = 0; i < data_length && out.Room() >= kHexDumpLineSize; i += 16) {
+        out.Advance(WriteHexLine(out.Cursor(), data + i, std::min<std::size_t>(16, data_length - i),
+                                 offset + static_cast<std::uint32_t>(i)));
+    }
+    return out.Finish();
+}
+
+std::size_t FormatTextLine(const TextLineFields &fields, char *buffer, std::size_t capacity) noexcept {
+    if (!buffer || capacity == 0) {
+        return 0;
+    }
+    // Later chunks of a binary payload continue the dump of the first one.
+    if (fields.hex_dump && fields.message_length >= kBinaryChunkHeaderSize &&
+        internal::LoadLe32(reinterpret_cast<const unsigned char *>(fields.message)) != 0) {
+        return FormatBinaryChunk(fields.message, fields.message_length, buffer, capacity);
     }
+    LineWriter out(buffer, capacity);
 
-    if (pos < capacity - 1) {
-        buffer[pos++] = '\n';
+    out.Append('[');
+    out.AppendU64(fields.timestamp_ns);
+    out.Append("] [", 3);
+    out.Append(LevelToString(fields.level));
+    out.Append(']');
+
+    if (fields.sample_rate > 1) {
+        out.Append(" [sample=1/", 11);
+        out.AppendU64(fields.sample_rate);
+        out.Append(']');
+    }
+
+    if (fields.has_thread_id) {
+        out.Append(" [tid=", 6);
+        out.AppendU64(fields.thread_id);
+        out.Append(']');
     }
 
-    buffer[pos] = '\0';
-    return pos;
+    if (fields.file && fields.function) {
+        out.Append(' ');
+        out.Append(fields.file);
+        out.Append(':');
+        out.AppendI32(fields.line);
+        out.Append(' ');
+        out.Append(fields.function);
+    }
+
+    if (fields.hex_dump) {
+        out.Append(' ');
+        out.Advance(FormatBinaryChunk(fields.message, fields.message_length, out.Cursor(), out.Room() + 1));
+        return out.Finish();
+    }
+
+    // The payload may contain '\n' or '\0', so it is copied by length.
+    out.Append(' ');
+    out.Append(fields.message, fields.message_length);
+    out.Append('\n');
+    return out.Finish();
+}
+
+const char *RecordPayload(const LogRecord &record, char *scratch, std::size_t &length) noexcept {
+#if LOGGER_ENABLE_CONTEXT
+    const bool has_context = record.context_length != 0;
+#else
+    const bool has_context = false;
+#endif
+    const bool text = record.kind == RecordKind::Message || record.kind == RecordKind::Literal;
+    if (LOGGER_LIKELY(text && !has_context) || record.kind == RecordKind::Binary) {
+        length = record.message_length;
+        return record.MessageData();
+    }
+    LineWriter out(scratch, kFormatScratchSize);
+#if LOGGER_ENABLE_CONTEXT
+    if (has_context) {
+        out.Append('[');
+        out.Append(record.context, record.context_length);
+        out.Append("] ", 2);
+    }
+#endif
+    out.Append(record.MessageData(), record.message_length);
+    if (record.kind == RecordKind::ScopeTimer) {
+        // The producer only stored the two TSC readings.
+        const std::uint64_t ticks =
+            record.end_timestamp > record.timestamp ? record.end_timestamp - record.timestamp : 0;
+        out.Append(" took ", 6);
+        out.AppendU64(internal::TscToNanoseconds(ticks));
+        out.Append(" ns", 3);
+    }
+    length = out.Finish();
+    return scratch;
+}
+
+std::size_t TextFormatter::FormatRecord(const LogRecord &record, char *buffer, std::size_t capacity) {
+    TextLineFields fields{};
+    fields.timestamp_ns = internal::TscToNanoseconds(record.timestamp);
+    fields.level = record.level;
+    fields.sample_rate = record.sample_rate;
+#if LOGGER_ENABLE_THREAD_ID
+    fields.has_thread_id = true;
+    fields.thread_id = record.thread_id;
+#endif
+#if LOGGER_ENABLE_SOURCE_LOCATION
+    fields.file = record.file;
+    fields.function = record.function;
+    fields.line = record.line;
+#endif
+    char payload[kFormatScratchSize];
+    fields.message = RecordPayload(record, payload, fields.message_length);
+    fields.hex_dump = record.kind == RecordKind::Binary;
+    return FormatTextLine(fields, buffer, capacity);
 }
 
 } // namespace logger
@@ -0,0 +1,177 @@
+#include "../include/histogram.h"
+
+#include <algorithm>
+#include <functional>
+#include <new>
+#include <thread>
+
+namespace logger {
+
+std::uint64_t LogLinearHistogram::BucketLow(std::size_t bucket) noexcept {
+    if (bucket < kSubBuckets) {
+        return bucket;
+    }
+    const std::size_t shift = bucket / kSubBuckets - 1;
+    return (kSubBuckets + bucket % kSubBuckets) << shift;
+}
+
+std::uint64_t LogLinearHistogram::BucketHigh(std::size_t bucket) noexcept {
+    if (bucket < kSubBuckets) {
+        return bucket;
+    }
+    const std::size_t shift = bucket / kSubBuckets - 1;
+    return BucketLow(bucket) + ((std::uint64_t{1} << shift) - 1);
+}
+
+void LogLinearHistogram::Record(std::uint64_t value, std::uint64_t times) noexcept {
+    if (times == 0) {
+        return;
+    }
+    counts_[BucketOf(value)] += times;
+    count_ += times;
+    sum_ += value * times;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+}
+
+void LogLinearHistogram::Merge(const LogLinearHistogram &other) noexcept {
+    if (other.count_ == 0) {
+        return;
+    }
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+        counts_[i] += other.counts_[i];
+    }
+    count_ += other.count_;
+    sum_ += other.sum_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+}
+
+void LogLinearHistogram::Reset() noexcept {
+    std::fill(counts_, counts_ + kBucketCount, 0);
+    count_ = 0;
+    sum_ = 0;
+    min_ = ~std::uint64_t{0};
+    max_ = 0;
+}
+
+std::uint64_t LogLinearHistogram::Percentile(double q) const noexcept {
+    if (count_ == 0) {
+        return 0;
+    }
+    q = std::clamp(q, 0.0, 1.0);
+    // Rank of the sample at quantile q (1-based), at least the first sample.
+    const std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(q * static_cast<double>(count_) + 0.5));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+        seen += counts_[i];
+        if (seen >= rank) {
+            const std::uint64_t low = BucketLow(i);
+            const std::uint64_t mid = low + (BucketHigh(i) - low) / 2;
+            return std::clamp(mid, Min(), max_);
+        }
+    }
+    return max_;
+}
+
+void HistogramCell::Buffer::Reset() noexcept {
+    for (std::atomic<std::uint64_t> &bucket : counts) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    min.store(~std::uint64_t{0}, std::memory_order_relaxed);
+    max.store(0, std::memory_order_relaxed);
+}
+
+void HistogramCell::Buffer::DrainInto(LogLinearHistogram &into) noexcept {
+    const std::uint64_t total = count.load(std::memory_order_relaxed);
+    if (total == 0) {
+        return;
+    }
+    for (std::size_t i = 0; i < LogLinearHistogram::kBucketCount; ++i) {
+        const std::uint64_t n = counts[i].load(std::memory_order_relaxed);
+        if (n != 0) {
+            into.counts_[i] += n;
+            counts[i].store(0, std::memory_order_relaxed);
+        }
+    }
+    into.count_ += total;
+    into.sum_ += sum.load(std::memory_order_relaxed);
+    into.min_ = std::min(into.min_, min.load(std::memory_order_relaxed));
+    into.max_ = std::max(into.max_, max.load(std::memory_order_relaxed));
+    count.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    min.store(~std::uint64_t{0}, std::memory_order_relaxed);
+    max.store(0, std::memory_order_relaxed);
+}
+
+void HistogramCell::Harvest(LogLinearHistogram &into, bool final) noexcept {
+    const std::uint32_t live = active_.load(std::memory_order_relaxed);
+    // Retired one harvest ago: producers have long moved to `live`.
+    buffers_[live ^ 1].DrainInto(into);
+    // Release publishes the zeroed buffer to producers that switch to it.
+    active_.store(live ^ 1, std::memory_order_release);
+    if (final) {
+        buffers_[live].DrainInto(into);
+    }
+}
+
+Histogram::Histogram(HistogramRegistry &registry, const char *name, Level level, const char *file, int line,
+                     const char *function) noexcept
+    : name_(name ? name : ""), level_(level), line_(line), file_(file), function_(function) {
+    registry.Add(*this);
+}
+
+HistogramCell *Histogram::NewCell() noexcept {
+    HistogramCell *cell = new (std::nothrow) HistogramCell();
+    if (!cell) {
+        return nullptr;
+    }
+    HistogramCell *head = cells_.load(std::memory_order_relaxed);
+    do {
+        cell->next_ = head;
+    } while (!cells_.compare_exchange_weak(head, cell, std::memory_order_release, std::memory_order_relaxed));
+    return cell;
+}
+
+void Histogram::Harvest(LogLinearHistogram &into, bool final) noexcept {
+    for (HistogramCell *cell = cells_.load(std::memory_order_acquire); cell; cell = cell->next_) {
+        cell->Harvest(into, final);
+    }
+}
+
+void Histogram::Summarize(const LogLinearHistogram &data, LogRecord &record) const noexcept {
+    record.level = level_;
+    record.kind = RecordKind::Message;
+    record.continuations = 0;
+    record.external_text = nullptr;
+    record.timestamp = internal::ReadTsc();
+    record.end_timestamp = 0;
+    record.sample_rate = 1;
+#if LOGGER_ENABLE_CONTEXT
+    record.context_id = 0;
+    record.context = nullptr;
+    record.context_length = 0;
+#endif
+#if LOGGER_ENABLE_THREAD_ID
+    record.thread_id = std::hash<std::thread::id>{}(std::this_thread::get_id());
+#endif
+#if LOGGER_ENABLE_SOURCE_LOCATION
+    record.SetSourceLocation(file_ && function_ ? file_ : nullptr, line_, file_ && function_ ? function_ : nullptr);
+#endif
+    const auto u = [](std::uint64_t value) { return static_cast<unsigned long long>(value); };
+    record.FormatMessage("%s n=%llu min=%llu p50=%llu p90=%llu p99=%llu p999=%llu max=%llu mean=%llu", name_,
+                         u(data.Count()), u(data.Min()), u(data.Percentile(0.50)), u(data.Percentile(0.90)),
+                         u(data.Percentile(0.99)), u(data.Percentile(0.999)), u(data.Max()),
+                         u(data.Count() ? data.Sum() / data.Count() : 0));
+}
+
+void HistogramRegistry::Add(Histogram &histogram) noexcept {
+    Histogram *head = head_.load(std::memory_order_relaxed);
+    do {
+        histogram.next_ = head;
+    } while (!head_.compare_exchange_weak(head, &histogram, std::memory_order_release, std::memory_order_relaxed));
+}
+
+} // namespace logger
@@ -0,0 +1,258 @@
+#include "../include/memory_sink.h"
+#include "../include/error.h"
+#include "../internal/platform.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#if defined(LOGGER_OS_POSIX)
+#include <csignal>
+#endif
+
+namespace logger {
+
+namespace {
+
+// Dumps copy through a bounded buffer allocated with the sink.
+constexpr std::size_t kDumpChunk = 64 * 1024;
+constexpr std::size_t kWordBytes = sizeof(std::uint64_t);
+
+// The ring is read while it is being overwritten (that is what the seqlock
+// check detects), so both sides go through relaxed word atomics instead of
+// memcpy: racy bytes are discarded, but the accesses themselves are defined.
+// Only the consumer stores, so merging a partial word is a plain load + store.
+void StoreBytes(std::atomic<std::uint64_t> *words, std::size_t offset, const char *data, std::size_t len) noexcept {
+    while (len > 0) {
+        const std::size_t shift = offset % kWordBytes;
+        const std::size_t n = std::min(len, kWordBytes - shift);
+        std::atomic<std::uint64_t> &word = words[offset / kWordBytes];
+        std::uint64_t value = (n == kWordBytes) ? 0 : word.load(std::memory_order_relaxed);
+        std::memcpy(reinterpret_cast<char *>(&value) + shift, data, n);
+        word.store(value, std::memory_order_relaxed);
+        offset += n;
+        data += n;
+        len -= n;
+    }
+}
+
+void LoadBytes(const std::atomic<std::uint64_t> *words, std::size_t offset, char *out, std::size_t len) noexcept {
+    while (len > 0) {
+        const std::size_t shift = offset % kWordBytes;
+        const std::size_t n = std::min(len, kWordBytes - shift);
+        const std::uint64_t value = words[offset / kWordBytes].load(std::memory_order_relaxed);
+        std::memcpy(out, reinterpret_cast<const char *>(&value) + shift, n);
+        offset += n;
+        out += n;
+        len -= n;
+    }
+}
+
+#if defined(LOGGER_OS_POSIX)
+constexpr int kMaxSignal = 65;
+std::atomic<MemoryRingSink *> g_signal_sinks[kMaxSignal];
+// Disposition each signal had before a sink took it over, restored when that sink goes away.
+struct sigaction g_previous_actions[kMaxSignal];
+// Handlers between loading a sink pointer and finishing RequestDump(); destructors wait for 0.
+std::atomic<int> g_handlers_running{0};
+
+extern "C" void MemoryRingSinkSignalHandler(int signo) {
+    if (signo > 0 && signo < kMaxSignal) {
+        g_handlers_running.fetch_add(1, std::memory_order_acquire);
+        MemoryRingSink *sink = g_signal_sinks[signo].load(std::memory_order_acquire);
+        if (sink) {
+            sink->RequestDump();
+        }
+        g_handlers_running.fetch_sub(1, std::memory_order_release);
+    }
+}
+#endif
+
+} // namespace
+
+MemoryRingSink::MemoryRingSink(std::size_t capacity, const char *dump_path, bool dump_on_fatal) noexcept
+    : buffer_(new std::atomic<std::uint64_t>[((capacity > 0 ? capacity : 1) + kWordBytes - 1) / kWordBytes]()),
+      capacity_(capacity > 0 ? capacity : 1),
+      chunk_(new char[std::min(capacity_, kDumpChunk)]),
+      dump_path_{},
+      dump_on_fatal_(dump_on_fatal) {
+    if (dump_path) {
+        if (std::strlen(dump_path) + 12 >= sizeof(dump_path_)) {
+            ReportError(ErrorCode::InvalidConfig, "MemoryRingSink: dump path too long, triggered dumps disabled");
+        } else {
+            std::memcpy(dump_path_, dump_path, std::strlen(dump_path) + 1);
+        }
+    }
+}
+
+MemoryRingSink::~MemoryRingSink() {
+#if defined(LOGGER_OS_POSIX)
+    for (int signo = 1; signo < kMaxSignal; ++signo) {
+        MemoryRingSink *expected = this;
+        if (g_signal_sinks[signo].compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel)) {
+            (void)sigaction(signo, &g_previous_actions[signo], nullptr);
+        }
+    }
+    // A handler on another thread may still hold the old pointer.
+    while (g_handlers_running.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+#endif
+}
+
+void MemoryRingSink::Write(const char *data, std::size_t len) {
+    if (LOGGER_UNLIKELY(dump_requested_.load(std::memory_order_relaxed))) {
+        DumpTriggered();
+    }
+    if (!data || len == 0) {
+        return;
+    }
+    if (len > capacity_) {
+        // Only the tail can survive anyway.
+        data += len - capacity_;
+        len = capacity_;
+    }
+
+    const std::uint64_t pos = committed_.load(std::memory_order_relaxed);
+    // Claim first: a reader that sees any of the new bytes must also see the claim.
+    claimed_.store(pos + len, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const std::size_t offset = static_cast<std::size_t>(pos % capacity_);
+    const std::size_t first = std::min(len, capacity_ - offset);
+    StoreBytes(buffer_.get(), offset, data, first);
+    StoreBytes(buffer_.get(), 0, data + first, len - first);
+
+    committed_.store(pos + len, std::memory_order_release);
+}
+
+void MemoryRingSink::Flush() {
+    if (LOGGER_UNLIKELY(dump_requested_.load(std::memory_order_relaxed))) {
+        DumpTriggered();
+    }
+}
+
+void MemoryRingSink::OnSevere(Level level) {
+    if (dump_on_fatal_ && level == Level::Fatal) {
+        DumpTriggered();
+    }
+}
+
+void MemoryRingSink::DumpTriggered() {
+    dump_requested_.store(false, std::memory_order_relaxed);
+    if (dump_path_[0] == '\0') {
+        return;
+    }
+    char path[sizeof(dump_path_) + 11]; // "." + up to 10 digits of the counter
+    const std::uint32_t seq = dump_count_.load(std::memory_order_relaxed);
+    std::snprintf(path, sizeof(path), "%s.%u", dump_path_, static_cast<unsigned>(seq));
+    if (DumpTo(path)) {
+        dump_count_.store(seq + 1, std::memory_order_relaxed);
+    }
+}
+
+bool MemoryRingSink::DumpTo(const char *path) const {
+    if (dumping_.exchange(true, std::memory_order_acquire)) {
+        ReportError(ErrorCode::WriteFailed, "MemoryRingSink dump already in progress");
+        return false;
+    }
+    const bool ok = DumpLocked(path);
+    dumping_.store(false, std::memory_order_release);
+    return ok;
+}
+
+bool MemoryRingSink::DumpLocked(const char *path) const {
+    std::FILE *file = path ? std::fopen(path, "wb") : nullptr;
+    if (!file) {
+        ReportError(ErrorCode::FileOpenFailed, "MemoryRingSink dump open failed");
+        return false;
+    }
+
+    char *const chunk = chunk_.get();
+    const std::size_t chunk_size = std::min(capacity_, kDumpChunk);
+    const std::uint64_t end = committed_.load(std::memory_order_acquire);
+    std::uint64_t pos = (end > capacity_) ? end - capacity_ : 0;
+    bool skip_partial_line = pos > 0; // oldest retained line was cut by the wrap
+    bool ok = true;
+
+    while (pos < end) {
+        const std::size_t want = static_cast<std::size_t>(std::min<std::uint64_t>(chunk_size, end - pos));
+        const std::size_t offset = static_cast<std::size_t>(pos % capacity_);
+        const std::size_t first = std::min(want, capacity_ - offset);
+        LoadBytes(buffer_.get(), offset, chunk, first);
+        LoadBytes(buffer_.get(), 0, chunk + first, want - first);
+
+        // Validate the copy: bytes below claimed - capacity may have been overwritten.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const std::uint64_t claimed = claimed_.load(std::memory_order_relaxed);
+        const std::uint64_t oldest_valid = (claimed > capacity_) ? claimed - capacity_ : 0;
+
+        std::size_t begin = 0;
+        if (oldest_valid > pos) {
+            const std::uint64_t lost = oldest_valid - pos;
+            if (lost >= want) {
+                pos = oldest_valid;
+                skip_partial_line = true;
+                continue;
+            }
+            begin = static_cast<std::size_t>(lost);
+            if (!skip_partial_line) {
+                // Writer lapped the dump mid-way: mark the discontinuity.
+                char marker[96];
+                const int n = std::snprintf(marker, sizeof(marker), "\n[LOGGER] ... %llu bytes overwritten during dump ...\n",
+                                            static_cast<unsigned long long>(lost));
+                ok = ok && std::fwrite(marker, 1, static_cast<std::size_t>(n), file) == static_cast<std::size_t>(n);
+            }
+            skip_partial_line = true;
+        }
+
+        if (skip_partial_line) {
+            while (begin < want && chunk[begin] != '\n') {
+                ++begin;
+            }
+            if (begin < want) {
+                ++begin; // drop the newline that ends the partial line
+                skip_partial_line = false;
+            }
+        }
+
+        if (begin < want) {
+            ok = ok && std::fwrite(chunk + begin, 1, want - begin, file) == want - begin;
+        }
+        pos += want;
+    }
+
+    if (std::fclose(file) != 0 || !ok) {
+        ReportError(ErrorCode::WriteFailed, "MemoryRingSink dump write failed");
+        return false;
+    }
+    return true;
+}
+
+bool MemoryRingSink::InstallDumpSignal(int signo) noexcept {
+#if defined(LOGGER_OS_POSIX)
+    if (signo <= 0 || signo >= kMaxSignal) {
+        return false;
+    }
+    g_signal_sinks[signo].store(this, std::memory_order_release);
+    struct sigaction action {};
+    action.sa_handler = MemoryRingSinkSignalHandler;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    struct sigaction previous {};
+    if (sigaction(signo, &action, &previous) != 0) {
+        g_signal_sinks[signo].store(nullptr, std::memory_order_release);
+        return false;
+    }
+    if (previous.sa_handler != MemoryRingSinkSignalHandler) {
+        g_previous_actions[signo] = previous; // a sink taking over from another keeps the original
+    }
+    return true;
+#else
+    (void)signo;
+    return false;
+#endif
+}
+
+} // namespace logger
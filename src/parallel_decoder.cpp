@@ -0,0 +1,136 @@
+#include "../include/parallel_decoder.h"
+#include "../include/formatter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace logger {
+
+namespace {
+
+// One reorder-buffer slot: block b renders into slot (b - first) % slots.
+struct Slot {
+    std::string text;
+    std::uint64_t records = 0;
+    bool corrupt = false;
+    bool ready = false;
+};
+
+} // namespace
+
+ParallelDecoder::ParallelDecoder(const DecodeOptions &options) noexcept
+    : threads_(options.threads != 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency())),
+      slots_(options.blocks_in_flight != 0 ? options.blocks_in_flight : std::size_t{4} * threads_) {}
+
+bool ParallelDecoder::RenderBlock(const BinaryLogReader &reader, std::size_t block, std::string &text,
+                                  std::uint64_t &records) {
+    const double ticks_per_ns = reader.TicksPerNanosecond();
+    char line[kFormatScratchSize];
+    TextLineFields fields{};
+#if LOGGER_ENABLE_THREAD_ID
+    fields.has_thread_id = true;
+#endif
+    // Text is usually 1-2x the binary size; reserve once per block.
+    text.reserve(text.size() + reader.Block(block).payload_len * 2);
+    return reader.ForEachRecord(block, [&](const BinaryRecordView &record) {
+        // Same conversion as internal::TscToNanoseconds, with the writer's calibration.
+        fields.timestamp_ns = static_cast<std::uint64_t>(static_cast<double>(record.timestamp) / ticks_per_ns);
+        fields.level = record.level;
+        fields.sample_rate = record.sample_rate;
+        fields.thread_id = record.thread_id;
+        fields.file = record.file[0] != '\0' ? record.file : nullptr;
+        fields.function = record.function;
+        fields.line = record.line;
+        fields.message = record.message;
+        fields.message_length = record.message_length;
+        fields.hex_dump = record.hex_dump;
+        text.append(line, FormatTextLine(fields, line, sizeof(line)));
+        ++records;
+    });
+}
+
+DecodeStats ParallelDecoder::Decode(const BinaryLogReader &reader, Sink &out, std::size_t first, std::size_t last) {
+    const auto start = std::chrono::steady_clock::now();
+    DecodeStats stats{};
+    last = std::min(last, reader.BlockCount());
+    if (first >= last) {
+        return stats;
+    }
+    const std::size_t count = last - first;
+    const std::size_t slot_count = std::min(slots_, count);
+    const unsigned workers = static_cast<unsigned>(std::min<std::size_t>(threads_, count));
+
+    std::unique_ptr<Slot[]> slots(new Slot[slot_count]);
+    std::mutex mutex;
+    std::condition_variable block_ready; // worker -> writer
+    std::condition_variable slot_free;   // writer -> workers
+    std::size_t next = 0;                // next block to hand out (relative to first)
+    std::size_t written = 0;             // blocks written so far
+
+    auto work = [&] {
+        for (;;) {
+            std::size_t index;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                // A worker may run at most slot_count blocks ahead of the writer.
+                slot_free.wait(lock, [&] { return next == count || next < written + slot_count; });
+                if (next == count) {
+                    return;
+                }
+                index = next++;
+            }
+            // The slot is exclusively ours until we mark it ready.
+            Slot &slot = slots[index % slot_count];
+            slot.text.clear();
+            slot.records = 0;
+            slot.corrupt = !RenderBlock(reader, first + index, slot.text, slot.records);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                slot.ready = true;
+            }
+            block_ready.notify_one();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers);
+    for (unsigned i = 0; i < workers; ++i) {
+        pool.emplace_back(work);
+    }
+
+    // Writer: emit blocks strictly in file order.
+    for (std::size_t index = 0; index < count; ++index) {
+        Slot &slot = slots[index % slot_count];
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            block_ready.wait(lock, [&] { return slot.ready; });
+        }
+        out.Write(slot.text.data(), slot.text.size());
+        stats.blocks += 1;
+        stats.corrupt_blocks += slot.corrupt ? 1 : 0;
+        stats.records += slot.records;
+        stats.input_bytes += BinaryFileSink::kBlockHeaderSize + reader.Block(first + index).payload_len;
+        stats.output_bytes += slot.text.size();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            slot.ready = false;
+            written = index + 1;
+        }
+        slot_free.notify_all();
+    }
+    for (std::thread &thread : pool) {
+        thread.join();
+    }
+    out.Flush();
+
+    stats.elapsed_ns = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    return stats;
+}
+
+} // namespace logger
@@ -0,0 +1,100 @@
+#include "../include/router.h"
+#include "../include/error.h"
+
+namespace logger {
+
+Router::Router(Formatter &formatter, Sink &sink) noexcept
+    : destination_count_(0), group_count_(0), sink_count_(0) {
+    const Destination only{&formatter, &sink, Level::Trace};
+    AddDestinations(&only, 1);
+}
+
+Router::Router(const Destination *destinations, std::size_t count) noexcept
+    : destination_count_(0), group_count_(0), sink_count_(0) {
+    AddDestinations(destinations, count);
+}
+
+void Router::AddDestinations(const Destination *destinations, std::size_t count) noexcept {
+    if (!destinations) {
+        count = 0;
+    }
+    if (count > LOGGER_MAX_DESTINATIONS) {
+        ReportError(ErrorCode::InvalidConfig, "Router: too many destinations, extra ignored");
+        count = LOGGER_MAX_DESTINATIONS;
+    }
+
+    // Lay destinations out grouped by formatter so each group is contiguous.
+    for (std::size_t i = 0; i < count; ++i) {
+        Formatter *formatter = destinations[i].formatter;
+        if (!formatter || !destinations[i].sink) {
+            ReportError(ErrorCode::InvalidConfig, "Router: destination without formatter or sink ignored");
+            continue;
+        }
+        bool seen = false;
+        for (std::size_t g = 0; g < group_count_; ++g) {
+            if (groups_[g].formatter == formatter) {
+                seen = true;
+                break;
+            }
+        }
+        if (seen) {
+            continue;
+        }
+
+        FormatterGroup &group = groups_[group_count_++];
+        group.formatter = formatter;
+        group.min_level = Level::Fatal;
+        group.begin = static_cast<std::uint8_t>(destination_count_);
+        for (std::size_t j = i; j < count; ++j) {
+            const Destination &candidate = destinations[j];
+            if (candidate.formatter != formatter || !candidate.sink) {
+                continue;
+            }
+            destinations_[destination_count_++] = candidate;
+            if (LevelToInt(candidate.min_level) < LevelToInt(group.min_level)) {
+                group.min_level = candidate.min_level;
+            }
+        }
+        group.end = static_cast<std::uint8_t>(destination_count_);
+    }
+
+    // Distinct sinks, so a sink shared by several destinations is flushed once.
+    for (std::size_t i = 0; i < destination_count_; ++i) {
+        Sink *sink = destinations_[i].sink;
+        bool seen = false;
+        for (std::size_t s = 0; s < sink_count_; ++s) {
+            if (sinks_[s] == sink) {
+                seen = true;
+                break;
+            }
+        }
+        if (!seen) {
+            sinks_[sink_count_++] = sink;
+        }
+    }
+}
+
+std::size_t Router::DispatchFanOut(const LogRecord &record, char *scratch, std::size_t capacity) {
+    std::size_t total = 0;
+    for (std::size_t g = 0; g < group_count_; ++g) {
+        const FormatterGroup &group = groups_[g];
+        if (!ShouldLog(record.level, group.min_level)) {
+            continue;
+        }
+        // Format once per formatter, then write to each matching sink.
+        const std::size_t len = group.formatter->FormatRecord(record, scratch, capacity);
+        for (std::size_t d = group.begin; d < group.end; ++d) {
+            const Destination &destination = destinations_[d];
+            if (ShouldLog(record.level, destination.min_level)) {
+                destination.sink->Write(scratch, len);
+                if (ShouldLog(record.level, Level::Error)) {
+                    destination.sink->OnSevere(record.level);
+                }
+                total += len;
+            }
+        }
+    }
+    return total;
+}
+
+} // namespace logger
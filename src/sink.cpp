@@ -1,16 +1,65 @@
 #include "../include/sink.h"
 #include "../include/error.h"
+#include "../internal/platform.h"
+
+#include <algorithm>
+#include <chrono>
+
+#if defined(LOGGER_OS_POSIX)
+#include <fcntl.h>
+#include <unistd.h>
+#elif defined(LOGGER_OS_WINDOWS)
+#include <io.h>
+#endif
 
 namespace logger {
 
-FileSink::FileSink(const char *path, const char *mode) noexcept
-    : file_(path ? std::fopen(path, mode) : nullptr) {
+namespace {
+
+// Push written data to stable storage. Data only, not metadata, where the OS allows it.
+bool SyncFile(std::FILE *file) noexcept {
+#if defined(LOGGER_OS_MACOS)
+    // fsync on macOS only reaches the drive cache; F_FULLFSYNC flushes it.
+    const int fd = fileno(file);
+    return ::fcntl(fd, F_FULLFSYNC) == 0 || ::fsync(fd) == 0;
+#elif defined(LOGGER_OS_LINUX)
+    return ::fdatasync(fileno(file)) == 0;
+#elif defined(LOGGER_OS_POSIX)
+    return ::fsync(fileno(file)) == 0;
+#elif defined(LOGGER_OS_WINDOWS)
+    return ::_commit(::_fileno(file)) == 0;
+#else
+    (void)file;
+    return false;
+#endif
+}
+
+} // namespace
+
+FileSink::FileSink(const char *path, const char *mode, DurabilityPolicy policy) noexcept
+    : file_(path ? std::fopen(path, mode) : nullptr), policy_(policy) {
     if (!file_ && path) {
         ReportError(ErrorCode::FileOpenFailed, "FileSink open failed");
     }
+    if (policy_.mode == DurabilityPolicy::Mode::Periodic && policy_.interval_ms == 0 && policy_.interval_bytes == 0) {
+        ReportError(ErrorCode::InvalidConfig, "FileSink: periodic durability without interval, syncs disabled");
+        policy_.mode = DurabilityPolicy::Mode::None;
+    }
+    next_sync_bytes_ = policy_.interval_bytes;
+    if (file_ && policy_.mode != DurabilityPolicy::Mode::None) {
+        sync_thread_ = std::thread(&FileSink::SyncLoop, this);
+    }
 }
 
 FileSink::~FileSink() {
+    if (sync_thread_.joinable()) {
+        // Everything written so far becomes durable before the file closes.
+        (void)std::fflush(file_);
+        PublishFlushed(true);
+        stopping_.store(true, std::memory_order_release);
+        WakeSyncThread();
+        sync_thread_.join();
+    }
     if (file_) {
         std::fclose(file_);
     }
@@ -23,6 +72,17 @@ void FileSink::Write(const char *data, std::size_t len) {
     if (std::fwrite(data, 1, len, file_) != len) {
         ReportError(ErrorCode::WriteFailed, "FileSink write failed");
     }
+    written_ += len;
+
+    if (LOGGER_UNLIKELY(policy_.mode != DurabilityPolicy::Mode::None)) {
+        // Tells the time trigger how much its own fflush covers.
+        accepted_.store(written_, std::memory_order_release);
+        if (policy_.interval_bytes != 0 && written_ >= next_sync_bytes_) {
+            next_sync_bytes_ = written_ + policy_.interval_bytes;
+            Flush();
+            PublishFlushed(true);
+        }
+    }
 }
 
 void FileSink::Flush() {
@@ -30,7 +90,113 @@ void FileSink::Flush() {
         if (std::fflush(file_) != 0) {
             ReportError(ErrorCode::FlushFailed, "FileSink flush failed");
         }
+        PublishFlushed(false);
+    }
+}
+
+void FileSink::OnSevere(Level level) {
+    (void)level;
+    if (policy_.mode == DurabilityPolicy::Mode::SyncOnError && file_) {
+        // Only the fflush happens here; the sync itself runs on the sync thread.
+        Flush();
+        PublishFlushed(true);
+    }
+}
+
+SyncStats FileSink::Stats() const noexcept {
+    return SyncStats{
+        syncs_.load(std::memory_order_relaxed),
+        failures_.load(std::memory_order_relaxed),
+        synced_bytes_.load(std::memory_order_acquire),
+        total_ns_.load(std::memory_order_relaxed),
+        max_ns_.load(std::memory_order_relaxed),
+        last_ns_.load(std::memory_order_relaxed),
+    };
+}
+
+void FileSink::PublishFlushed(bool request_sync) noexcept {
+    flushed_.store(written_, std::memory_order_release);
+    if (request_sync) {
+        sync_target_.store(written_, std::memory_order_release);
+        WakeSyncThread();
+    }
+}
+
+void FileSink::WakeSyncThread() noexcept {
+    if (!sync_thread_.joinable()) {
+        return;
+    }
+    // Taking the lock orders the store above before the sync thread's predicate check.
+    { std::lock_guard<std::mutex> lock(sync_mutex_); }
+    sync_cv_.notify_one();
+}
+
+void FileSink::SyncLoop() {
+    using Clock = std::chrono::steady_clock;
+    const auto interval = std::chrono::milliseconds(policy_.interval_ms);
+    const bool timed = policy_.mode == DurabilityPolicy::Mode::Periodic && policy_.interval_ms != 0;
+    auto last_tick = Clock::now();
+    std::uint64_t handled = 0; // highest target attempted (failed syncs are not retried)
+
+    for (;;) {
+        const bool stopping = stopping_.load(std::memory_order_acquire);
+        std::uint64_t target = sync_target_.load(std::memory_order_acquire);
+
+        if (timed && Clock::now() - last_tick >= interval) {
+            last_tick = Clock::now();
+            // Bytes accepted by stdio before this fflush are in the kernel after it,
+            // even if the consumer never writes again (stdio locks the stream).
+            const std::uint64_t accepted = accepted_.load(std::memory_order_acquire);
+            if (accepted > handled) {
+                if (std::fflush(file_) == 0) {
+                    target = std::max(target, accepted);
+                } else {
+                    ReportError(ErrorCode::FlushFailed, "FileSink periodic flush failed");
+                }
+            }
+        }
+
+        if (target > handled) {
+            handled = target;
+            SyncOnce(target);
+        } else if (stopping) {
+            break;
+        } else {
+            // Sleep until a sync request, stop, or the next time trigger; never poll.
+            const auto ready = [&] {
+                return stopping_.load(std::memory_order_acquire) ||
+                       sync_target_.load(std::memory_order_acquire) > handled;
+            };
+            std::unique_lock<std::mutex> lock(sync_mutex_);
+            if (timed) {
+                sync_cv_.wait_until(lock, last_tick + interval, ready);
+            } else {
+                sync_cv_.wait(lock, ready);
+            }
+        }
+    }
+}
+
+bool FileSink::SyncOnce(std::uint64_t target) {
+    const auto start = std::chrono::steady_clock::now();
+    const bool ok = SyncFile(file_);
+    const auto ns = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+
+    if (!ok) {
+        failures_.fetch_add(1, std::memory_order_relaxed);
+        ReportError(ErrorCode::SyncFailed, "FileSink sync failed");
+        return false;
+    }
+    // Single writer (this thread): plain load/store is enough.
+    syncs_.store(syncs_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    total_ns_.store(total_ns_.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+    last_ns_.store(ns, std::memory_order_relaxed);
+    if (ns > max_ns_.load(std::memory_order_relaxed)) {
+        max_ns_.store(ns, std::memory_order_relaxed);
     }
+    synced_bytes_.store(target, std::memory_order_release);
+    return true;
 }
 
 ConsoleSink::ConsoleSink(Stream stream) noexcept
@@ -0,0 +1,247 @@
+#include "../include/socket_sink.h"
+#include "../include/error.h"
+
+#if defined(LOGGER_OS_POSIX)
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace logger {
+
+namespace {
+
+#if defined(MSG_NOSIGNAL)
+constexpr int kSendFlags = MSG_NOSIGNAL | MSG_DONTWAIT;
+#else
+constexpr int kSendFlags = MSG_DONTWAIT; // SIGPIPE suppressed with SO_NOSIGPIPE instead
+#endif
+
+std::uint64_t SteadyNanoseconds() noexcept {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                          std::chrono::steady_clock::now().time_since_epoch())
+                                          .count());
+}
+
+} // namespace
+
+UnixSocketSink::UnixSocketSink(const char *path, const UnixSocketSinkOptions &options) noexcept
+    : options_(options),
+      path_{},
+      fd_(-1),
+      read_pos_(0),
+      write_pos_(0),
+      next_connect_ns_(0),
+      backoff_ms_(options.reconnect_initial_ms) {
+    if (!path || std::strlen(path) >= sizeof(path_)) {
+        ReportError(ErrorCode::InvalidConfig, "UnixSocketSink: socket path missing or too long");
+        return;
+    }
+    std::memcpy(path_, path, std::strlen(path) + 1);
+
+    options_.spill_capacity = std::max<std::size_t>(options_.spill_capacity, 4096);
+    options_.batch_size = std::clamp<std::size_t>(options_.batch_size, 256, options_.spill_capacity);
+    if (options_.reconnect_initial_ms == 0) {
+        options_.reconnect_initial_ms = 1;
+    }
+    options_.reconnect_max_ms = std::max(options_.reconnect_max_ms, options_.reconnect_initial_ms);
+    backoff_ms_ = options_.reconnect_initial_ms;
+
+    spill_.reset(new char[options_.spill_capacity]);
+    if (options_.type == UnixSocketSinkOptions::Type::SeqPacket) {
+        packet_.reset(new char[options_.batch_size]);
+    }
+
+    TryConnect();
+}
+
+UnixSocketSink::~UnixSocketSink() {
+    // Last non-blocking attempt; anything the peer cannot take now is lost.
+    Flush();
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+void UnixSocketSink::Write(const char *data, std::size_t len) {
+    if (!spill_ || !data || len == 0) {
+        return;
+    }
+
+    if (len > options_.spill_capacity - PendingBytes()) {
+        SendPending();
+        if (len > options_.spill_capacity - PendingBytes()) {
+            // Spill ring full: drop the new write whole (same policy as the ring buffer).
+            dropped_bytes_.fetch_add(len, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    const std::size_t capacity = options_.spill_capacity;
+    const std::size_t offset = static_cast<std::size_t>(write_pos_ % capacity);
+    const std::size_t first = std::min(len, capacity - offset);
+    std::memcpy(spill_.get() + offset, data, first);
+    std::memcpy(spill_.get(), data + first, len - first);
+    write_pos_ += len;
+
+    if (PendingBytes() >= options_.send_threshold) {
+        SendPending();
+    }
+}
+
+void UnixSocketSink::Flush() {
+    if (spill_) {
+        SendPending();
+    }
+}
+
+SocketSinkStats UnixSocketSink::Stats() const noexcept {
+    return SocketSinkStats{
+        sent_bytes_.load(std::memory_order_relaxed),
+        dropped_bytes_.load(std::memory_order_relaxed),
+        send_calls_.load(std::memory_order_relaxed),
+        connects_.load(std::memory_order_relaxed),
+        disconnects_.load(std::memory_order_relaxed),
+    };
+}
+
+void UnixSocketSink::TryConnect() {
+    if (path_[0] == '\0') {
+        return;
+    }
+    const std::uint64_t now = SteadyNanoseconds();
+    if (now < next_connect_ns_) {
+        return; // not due yet; never wait here
+    }
+
+    const int type = (options_.type == UnixSocketSinkOptions::Type::SeqPacket) ? SOCK_SEQPACKET : SOCK_STREAM;
+    int fd = ::socket(AF_UNIX, type, 0);
+    if (fd >= 0) {
+        const int flags = ::fcntl(fd, F_GETFL, 0);
+        (void)::fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+#if defined(SO_NOSIGPIPE)
+        const int one = 1;
+        (void)::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, path_, std::strlen(path_) + 1);
+        if (::connect(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) == 0) {
+            fd_ = fd;
+            backoff_ms_ = options_.reconnect_initial_ms;
+            connects_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        ::close(fd);
+    }
+
+    // Daemon absent or busy: back off (capped) and keep spilling meanwhile.
+    next_connect_ns_ = now + static_cast<std::uint64_t>(backoff_ms_) * 1000000ull;
+    backoff_ms_ = std::min(backoff_ms_ * 2, options_.reconnect_max_ms);
+}
+
+void UnixSocketSink::Disconnect() {
+    ::close(fd_);
+    fd_ = -1;
+    disconnects_.fetch_add(1, std::memory_order_relaxed);
+    next_connect_ns_ = SteadyNanoseconds() + static_cast<std::uint64_t>(backoff_ms_) * 1000000ull;
+
+    // A stream peer may have received half a line; resume at the next line
+    // so the new connection starts on a record boundary.
+    if (options_.type == UnixSocketSinkOptions::Type::Stream && read_pos_ > 0) {
+        const std::size_t capacity = options_.spill_capacity;
+        if (spill_[static_cast<std::size_t>((read_pos_ - 1) % capacity)] != '\n') {
+            while (read_pos_ < write_pos_) {
+                const char c = spill_[static_cast<std::size_t>(read_pos_ % capacity)];
+                ++read_pos_;
+                dropped_bytes_.fetch_add(1, std::memory_order_relaxed);
+                if (c == '\n') {
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void UnixSocketSink::SendPending() {
+    if (fd_ < 0) {
+        TryConnect();
+        if (fd_ < 0) {
+            return;
+        }
+    }
+    const bool stream = options_.type == UnixSocketSinkOptions::Type::Stream;
+    while (PendingBytes() > 0) {
+        if (!(stream ? SendStream() : SendPacket())) {
+            break;
+        }
+    }
+}
+
+bool UnixSocketSink::SendStream() {
+    const std::size_t capacity = options_.spill_capacity;
+    const std::size_t offset = static_cast<std::size_t>(read_pos_ % capacity);
+    const std::size_t chunk = std::min({PendingBytes(), capacity - offset, options_.batch_size});
+
+    send_calls_.fetch_add(1, std::memory_order_relaxed);
+    const ssize_t sent = ::send(fd_, spill_.get() + offset, chunk, kSendFlags);
+    if (sent > 0) {
+        read_pos_ += static_cast<std::uint64_t>(sent);
+        sent_bytes_.fetch_add(static_cast<std::uint64_t>(sent), std::memory_order_relaxed);
+        return true;
+    }
+    if (sent < 0 && errno == EINTR) {
+        return true;
+    }
+    if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return false; // peer is slow: keep the rest spilled
+    }
+    Disconnect();
+    return false;
+}
+
+bool UnixSocketSink::SendPacket() {
+    const std::size_t capacity = options_.spill_capacity;
+    const std::size_t offset = static_cast<std::size_t>(read_pos_ % capacity);
+    std::size_t len = std::min(PendingBytes(), options_.batch_size);
+    const std::size_t first = std::min(len, capacity - offset);
+    std::memcpy(packet_.get(), spill_.get() + offset, first);
+    std::memcpy(packet_.get() + first, spill_.get(), len - first);
+
+    // Packets carry whole lines unless a single line exceeds batch_size.
+    if (len < PendingBytes()) {
+        std::size_t cut = len;
+        while (cut > 0 && packet_[cut - 1] != '\n') {
+            --cut;
+        }
+        if (cut > 0) {
+            len = cut;
+        }
+    }
+
+    send_calls_.fetch_add(1, std::memory_order_relaxed);
+    const ssize_t sent = ::send(fd_, packet_.get(), len, kSendFlags);
+    if (sent >= 0) {
+        read_pos_ += len; // packets are all-or-nothing
+        sent_bytes_.fetch_add(len, std::memory_order_relaxed);
+        return true;
+    }
+    if (errno == EINTR) {
+        return true;
+    }
+    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS) {
+        return false;
+    }
+    Disconnect();
+    return false;
+}
+
+} // namespace logger
+
+#endif // LOGGER_OS_POSIX
@@ -0,0 +1,277 @@
+#include "../include/backend.h"
+#include "../include/formatter.h"
+#include "../include/logger.h"
+#include "../include/sink.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Keeps every line (and the raw byte stream); written only by the draining thread.
+class CaptureSink final : public logger::Sink {
+  public:
+    void Write(const char *data, std::size_t len) override {
+        lines.emplace_back(data, len);
+        bytes.append(data, len);
+    }
+    void Flush() override {}
+    std::vector<std::string> lines;
+    std::string bytes;
+};
+
+std::vector<logger::IndexEntry> ReadIndex(const char *path) {
+    std::vector<logger::IndexEntry> entries;
+    std::FILE *file = std::fopen(path, "rb");
+    assert(file);
+    logger::IndexEntry entry;
+    while (std::fread(&entry, sizeof(entry), 1, file) == 1) {
+        entries.push_back(entry);
+    }
+    std::fclose(file);
+    return entries;
+}
+
+// Index of the last line containing `needle`, or -1.
+long LastIndexOf(const std::vector<std::string> &lines, const char *needle) {
+    for (std::size_t i = lines.size(); i > 0; --i) {
+        if (lines[i - 1].find(needle) != std::string::npos) {
+            return static_cast<long>(i - 1);
+        }
+    }
+    return -1;
+}
+
+// CaptureSink that stalls on every write, to keep one shard busy.
+class SlowCaptureSink final : public logger::Sink {
+  public:
+    void Write(const char *data, std::size_t len) override {
+        capture.Write(data, len);
+        std::this_thread::sleep_for(std::chrono::microseconds(20));
+    }
+    void Flush() override {}
+    CaptureSink capture;
+};
+
+using SmallLogger = logger::Logger<1024>;
+using BigLogger = logger::Logger<8192>;
+
+} // namespace
+
+int main() {
+    logger::TextFormatter formatter;
+
+    // Several named loggers, one backend thread, each with its own sink.
+    {
+        logger::Backend backend;
+        backend.Start();
+        CaptureSink sinks[3];
+        const char *names[3] = {"orders", "risk", "md"};
+        std::vector<std::unique_ptr<SmallLogger>> loggers;
+        for (int i = 0; i < 3; ++i) {
+            loggers.push_back(std::make_unique<SmallLogger>(backend, names[i], formatter, sinks[i]));
+            loggers.back()->Start();
+        }
+        assert(backend.ChannelCount() == 3);
+        assert(std::string(loggers[1]->Name()) == "risk");
+
+        std::vector<std::thread> producers;
+        for (int i = 0; i < 3; ++i) {
+            producers.emplace_back([&, i] {
+                for (int n = 0; n < 5000; ++n) {
+                    while (loggers[i]->LogFormat(logger::Level::Info, "%s seq=%d", names[i], n) ==
+                           logger::LogResult::BufferFull) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (std::thread &producer : producers) {
+            producer.join();
+        }
+        loggers.clear(); // unregister + drain the remainder on this thread
+        assert(backend.ChannelCount() == 0);
+
+        for (int i = 0; i < 3; ++i) {
+            assert(sinks[i].lines.size() == 5000);
+            char expected[64];
+            std::snprintf(expected, sizeof(expected), "%s seq=4999", names[i]);
+            assert(sinks[i].lines.back().find(expected) != std::string::npos);
+        }
+    }
+
+    // Runtime level filter.
+    {
+        logger::Backend backend;
+        CaptureSink sink;
+        auto audit = std::make_unique<SmallLogger>(backend, "audit", formatter, sink);
+        audit->SetLevel(logger::Level::Warn);
+        assert(!audit->IsEnabled(logger::Level::Info));
+        assert(audit->Info("dropped") == logger::LogResult::Filtered);
+        assert(audit->LogFormat(logger::Level::Debug, "n=%d", 1) == logger::LogResult::Filtered);
+        assert(audit->Error("kept") == logger::LogResult::Success);
+        audit->Start();
+        audit.reset();
+        assert(sink.lines.size() == 1 && sink.lines[0].find("kept") != std::string::npos);
+    }
+
+    // Fairness: a quiet logger is not stuck behind a noisy one's backlog.
+    {
+        logger::Backend backend;
+        CaptureSink shared;
+        auto noisy = std::make_unique<BigLogger>(backend, "noisy", formatter, shared);
+        auto quiet = std::make_unique<BigLogger>(backend, "quiet", formatter, shared);
+        for (int n = 0; n < 4000; ++n) {
+            assert(noisy->LogFormat(logger::Level::Info, "noisy %d", n) == logger::LogResult::Success);
+        }
+        for (int n = 0; n < 10; ++n) {
+            assert(quiet->LogFormat(logger::Level::Info, "quiet %d", n) == logger::LogResult::Success);
+        }
+        noisy->Start();
+        quiet->Start();
+        backend.Start();
+        while (noisy->PendingCount() > 0 || quiet->PendingCount() > 0) {
+            std::this_thread::yield();
+        }
+        backend.Stop();
+        assert(shared.lines.size() == 4010);
+        // Quiet gets at least one record per pass, so it finishes ~1400 noisy records early.
+        assert(LastIndexOf(shared.lines, "quiet 9") + 1000 < LastIndexOf(shared.lines, "noisy 3999"));
+    }
+
+    // Shards: K threads, one output and one ordering index per shard.
+    {
+        constexpr int kShards = 3;
+        constexpr int kLoggers = 6;
+        constexpr int kPerLogger = 3000;
+        logger::Backend backend(kShards);
+        CaptureSink outputs[kShards];
+        std::unique_ptr<logger::FileSink> indexes[kShards];
+        char index_paths[kShards][64];
+        for (int i = 0; i < kShards; ++i) {
+            std::snprintf(index_paths[i], sizeof(index_paths[i]), "/tmp/lll_backend_test_%d.idx", i);
+            indexes[i] = std::make_unique<logger::FileSink>(index_paths[i], "wb");
+            assert(backend.SetShardDestination(static_cast<std::size_t>(i), formatter, outputs[i]));
+            assert(backend.SetShardIndex(static_cast<std::size_t>(i), *indexes[i]));
+        }
+        backend.Start();
+
+        std::vector<std::unique_ptr<SmallLogger>> loggers;
+        for (int i = 0; i < kLoggers; ++i) {
+            char name[16];
+            std::snprintf(name, sizeof(name), "lane%d", i);
+            loggers.push_back(std::make_unique<SmallLogger>(backend, name));
+            loggers.back()->Start();
+        }
+        std::vector<std::thread> producers;
+        for (int i = 0; i < kLoggers; ++i) {
+            producers.emplace_back([&, i] {
+                for (int n = 0; n < kPerLogger; ++n) {
+                    while (loggers[i]->LogFormat(logger::Level::Info, "lane%d seq=%d", i, n) ==
+                           logger::LogResult::BufferFull) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (std::thread &producer : producers) {
+            producer.join();
+        }
+        loggers.clear();
+        backend.Stop();
+        indexes[0].reset();
+        indexes[1].reset();
+        indexes[2].reset();
+
+        std::size_t total = 0;
+        for (int shard = 0; shard < kShards; ++shard) {
+            // Round-robin placement: two lanes per shard, each lane complete and in order.
+            assert(outputs[shard].lines.size() == 2 * kPerLogger);
+            total += outputs[shard].lines.size();
+            const std::vector<logger::IndexEntry> entries = ReadIndex(index_paths[shard]);
+            assert(entries.size() == outputs[shard].lines.size());
+            for (std::size_t i = 0; i < entries.size(); ++i) {
+                assert(entries[i].shard == static_cast<std::uint32_t>(shard));
+                assert(outputs[shard].bytes.compare(entries[i].offset, outputs[shard].lines[i].size(),
+                                                    outputs[shard].lines[i]) == 0);
+            }
+        }
+        assert(total == kLoggers * kPerLogger);
+
+        const char *paths[kShards] = {index_paths[0], index_paths[1], index_paths[2]};
+        assert(logger::MergeShardIndexes(paths, kShards, "/tmp/lll_backend_test_merged.idx"));
+        const std::vector<logger::IndexEntry> merged = ReadIndex("/tmp/lll_backend_test_merged.idx");
+        assert(merged.size() == total);
+        for (std::size_t i = 1; i < merged.size(); ++i) {
+            assert(merged[i - 1].timestamp <= merged[i].timestamp);
+        }
+        for (const char *path : paths) {
+            std::remove(path);
+        }
+        std::remove("/tmp/lll_backend_test_merged.idx");
+    }
+
+    // Work stealing: while its shard is busy with a slow lane, an idle peer
+    // drains batches of the hot lane pinned next to it.
+    {
+        logger::Backend backend(2, true);
+        SlowCaptureSink slow_owner;
+        CaptureSink thief_output;
+        logger::Sink *outputs[2] = {&slow_owner, &thief_output};
+        std::unique_ptr<logger::FileSink> indexes[2];
+        char index_paths[2][64];
+        for (int i = 0; i < 2; ++i) {
+            std::snprintf(index_paths[i], sizeof(index_paths[i]), "/tmp/lll_backend_steal_%d.idx", i);
+            indexes[i] = std::make_unique<logger::FileSink>(index_paths[i], "wb");
+            assert(backend.SetShardDestination(static_cast<std::size_t>(i), formatter, *outputs[i]));
+            assert(backend.SetShardIndex(static_cast<std::size_t>(i), *indexes[i]));
+        }
+        auto busy = std::make_unique<BigLogger>(backend, "busy", 0);
+        auto hot = std::make_unique<BigLogger>(backend, "hot", 0);
+        for (int n = 0; n < 8000; ++n) {
+            assert(hot->LogFormat(logger::Level::Info, "seq=%d", n) == logger::LogResult::Success);
+        }
+        for (int n = 0; n < 2000; ++n) {
+            assert(busy->LogFormat(logger::Level::Info, "seq=%d", n) == logger::LogResult::Success);
+        }
+        hot->Start();
+        busy->Start();
+        backend.Start();
+        hot.reset(); // waits until the shards drained the lane
+        busy.reset();
+        backend.Stop();
+        indexes[0].reset();
+        indexes[1].reset();
+
+        const logger::ShardStats owner = backend.GetShardStats(0);
+        const logger::ShardStats thief = backend.GetShardStats(1);
+        assert(owner.records + thief.records == 10000);
+        assert(thief.steals > 0 && thief.stolen_records == thief.records && owner.steals == 0);
+
+        // Per-lane order survives: in timestamp order each lane's sequence numbers are consecutive.
+        const char *paths[2] = {index_paths[0], index_paths[1]};
+        assert(logger::MergeShardIndexes(paths, 2, "/tmp/lll_backend_steal_merged.idx"));
+        const std::vector<logger::IndexEntry> merged = ReadIndex("/tmp/lll_backend_steal_merged.idx");
+        assert(merged.size() == 10000);
+        int next_seq[LOGGER_MAX_BACKEND_CHANNELS] = {};
+        for (const logger::IndexEntry &entry : merged) {
+            const std::string &bytes = entry.shard == 0 ? slow_owner.capture.bytes : thief_output.bytes;
+            const std::size_t at = bytes.find("seq=", entry.offset);
+            assert(at != std::string::npos && std::atoi(bytes.c_str() + at + 4) == next_seq[entry.lane]);
+            ++next_seq[entry.lane];
+        }
+        for (const char *path : paths) {
+            std::remove(path);
+        }
+        std::remove("/tmp/lll_backend_steal_merged.idx");
+    }
+
+    return 0;
+}
@@ -0,0 +1,158 @@
+#include "../include/binary_log.h"
+#include "../include/logger.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr const char *kPath = "/tmp/lll_binary_log_test.lllb";
+constexpr const char *kTornPath = "/tmp/lll_binary_log_test_torn.lllb";
+constexpr int kRecords = 3000;
+
+int SeqOf(const logger::BinaryRecordView &record) {
+    const std::string message(record.message, record.message_length);
+    const std::size_t at = message.find("seq=");
+    assert(at != std::string::npos);
+    return std::atoi(message.c_str() + at + 4);
+}
+
+} // namespace
+
+int main() {
+    {
+        logger::BinaryFormatter formatter;
+        logger::BinaryFileSink sink(kPath, 4096);
+        auto instance = std::make_unique<logger::Logger<4096>>(formatter, sink);
+        for (int n = 0; n < kRecords; ++n) {
+            const logger::Level level = n % 500 == 0 ? logger::Level::Error : logger::Level::Info;
+            assert(instance->LogFormat(level, "order seq=%d qty=%d", n, n % 7) == logger::LogResult::Success);
+        }
+        instance->Start();
+        instance.reset(); // drains and flushes before the sink writes its index
+    }
+
+    logger::BinaryLogReader reader;
+    assert(reader.Open(kPath));
+    assert(reader.HasFooterIndex());
+    assert(reader.BlockCount() > 10);
+
+    // Every record decodes, in order, with its level reflected in the block bitmap.
+    std::vector<std::uint64_t> timestamps;
+    std::size_t error_blocks = 0;
+    for (std::size_t block = 0; block < reader.BlockCount(); ++block) {
+        bool has_error = false;
+        assert(reader.ForEachRecord(block, [&](const logger::BinaryRecordView &record) {
+            assert(SeqOf(record) == static_cast<int>(timestamps.size()));
+            has_error |= record.level == logger::Level::Error;
+            timestamps.push_back(record.timestamp);
+        }));
+        const bool error_bit = (reader.Block(block).level_mask >> logger::LevelToInt(logger::Level::Error)) & 1u;
+        assert(error_bit == has_error);
+        error_blocks += has_error ? 1 : 0;
+    }
+    assert(timestamps.size() == kRecords);
+    assert(error_blocks == kRecords / 500);
+
+    // Time range: the candidate blocks cover exactly the records in range, plus block edges.
+    std::size_t first = 0;
+    std::size_t last = 0;
+    reader.FindBlocks(timestamps[1000], timestamps[1999], first, last);
+    assert(first < last);
+    assert(reader.Block(first).min_tsc <= timestamps[1000] && reader.Block(first).max_tsc >= timestamps[1000]);
+    assert(first == 0 || reader.Block(first - 1).max_tsc < timestamps[1000]);
+    assert(last == reader.BlockCount() || reader.Block(last).min_tsc > timestamps[1999]);
+    std::size_t in_range = 0;
+    for (std::size_t block = first; block < last; ++block) {
+        reader.ForEachRecord(block, [&](const logger::BinaryRecordView &record) {
+            in_range += record.timestamp >= timestamps[1000] && record.timestamp <= timestamps[1999];
+        });
+    }
+    assert(in_range == 1000);
+    reader.FindBlocks(timestamps.back() + 1, ~std::uint64_t{0}, first, last);
+    assert(first == last);
+
+    // Text rendering and wall-clock conversion.
+    reader.ForEachRecord(0, [&](const logger::BinaryRecordView &record) {
+        if (SeqOf(record) == 0) {
+            char line[logger::kFormatScratchSize];
+            const std::size_t len = reader.FormatText(record, line, sizeof(line));
+            assert(len > 0 && line[len - 1] == '\n');
+            assert(std::strstr(line, "[ERROR]") && std::strstr(line, "order seq=0 qty=0"));
+            const std::uint64_t round_trip = reader.UnixNsToTsc(reader.TscToUnixNs(record.timestamp));
+            assert(round_trip + 16 >= record.timestamp && round_trip <= record.timestamp + 16);
+        }
+    });
+
+    // A file without its trailer (crash) is indexed by walking the block headers.
+    const std::uint64_t end_of_blocks =
+        reader.Block(reader.BlockCount() - 1).file_offset + logger::BinaryFileSink::kBlockHeaderSize +
+        reader.Block(reader.BlockCount() - 1).payload_len;
+    {
+        std::FILE *in = std::fopen(kPath, "rb");
+        std::FILE *out = std::fopen(kTornPath, "wb");
+        assert(in && out);
+        std::vector<char> bytes(static_cast<std::size_t>(end_of_blocks));
+        assert(std::fread(bytes.data(), 1, bytes.size(), in) == bytes.size());
+        assert(std::fwrite(bytes.data(), 1, bytes.size() - 10, out) == bytes.size() - 10); // torn last block
+        std::fclose(in);
+        std::fclose(out);
+    }
+    logger::BinaryLogReader torn;
+    assert(torn.Open(kTornPath));
+    assert(!torn.HasFooterIndex());
+    assert(torn.BlockCount() == reader.BlockCount() - 1);
+    assert(torn.Block(3).file_offset == reader.Block(3).file_offset);
+
+    // A record larger than a block is written as a block of its own; later blocks keep the configured size.
+    {
+        logger::BinaryFileSink sink(kTornPath, 4096);
+        std::vector<char> record(6000, 0);
+        for (std::size_t size : {1000, 1000, 1000, 6000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000}) {
+            sink.Write(record.data(), size);
+        }
+    }
+    {
+        logger::BinaryLogReader split;
+        assert(split.Open(kTornPath));
+        assert(split.HasFooterIndex());
+        const std::uint32_t expected[] = {3000, 6000, 4000, 4000};
+        assert(split.BlockCount() == 4);
+        for (std::size_t block = 0; block < 4; ++block) {
+            assert(split.Block(block).payload_len == expected[block]);
+        }
+    }
+
+    // A footer index whose block offsets would wrap past 2^64 is rejected, not trusted.
+    {
+        std::FILE *file = std::fopen(kTornPath, "r+b");
+        assert(file);
+        std::fseek(file, -static_cast<long>(logger::BinaryFileSink::kFooterSize), SEEK_END);
+        unsigned char footer[8];
+        assert(std::fread(footer, 1, sizeof(footer), file) == sizeof(footer));
+        std::uint64_t index_offset = 0;
+        for (int i = 7; i >= 0; --i) {
+            index_offset = index_offset << 8 | footer[i];
+        }
+        std::fseek(file, static_cast<long>(index_offset), SEEK_SET);
+        const unsigned char wrapping[8] = {0xF0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+        assert(std::fwrite(wrapping, 1, sizeof(wrapping), file) == sizeof(wrapping));
+        std::fclose(file);
+
+        logger::BinaryLogReader corrupt;
+        assert(corrupt.Open(kTornPath));
+        assert(!corrupt.HasFooterIndex()); // fell back to walking the block headers
+        assert(corrupt.BlockCount() == 4);
+    }
+
+    std::remove(kPath);
+    std::remove(kTornPath);
+    return 0;
+}
@@ -0,0 +1,142 @@
+#include "../include/compressed_sink.h"
+#include "../internal/block_codec.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string MakeLine(int i) {
+    char line[128];
+    const int n = std::snprintf(line, sizeof(line), "[%d] [INFO] [tid=7] order id=%d px=101.%02d qty=%d\n",
+                                1000000 + i * 37, i, i % 100, (i * 13) % 500);
+    return std::string(line, static_cast<std::size_t>(n));
+}
+
+// Little-endian u64 at `offset` (from the end when negative).
+std::uint64_t ReadLe64At(const char *path, long offset) {
+    std::FILE *file = std::fopen(path, "rb");
+    assert(file);
+    std::fseek(file, offset, offset < 0 ? SEEK_END : SEEK_SET);
+    unsigned char bytes[8];
+    assert(std::fread(bytes, 1, sizeof(bytes), file) == sizeof(bytes));
+    std::fclose(file);
+    std::uint64_t value = 0;
+    for (int i = 7; i >= 0; --i) {
+        value = value << 8 | bytes[i];
+    }
+    return value;
+}
+
+void PatchLe64At(const char *path, long offset, std::uint64_t value) {
+    std::FILE *file = std::fopen(path, "r+b");
+    assert(file);
+    std::fseek(file, offset, offset < 0 ? SEEK_END : SEEK_SET);
+    unsigned char bytes[8];
+    for (int i = 0; i < 8; ++i) {
+        bytes[i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+    assert(std::fwrite(bytes, 1, sizeof(bytes), file) == sizeof(bytes));
+    std::fclose(file);
+}
+
+} // namespace
+
+int main() {
+    using namespace logger::internal;
+
+    // Codec round trip on repetitive text, random bytes and tiny inputs.
+    std::vector<std::uint32_t> table(kLz4HashSize);
+    std::string text;
+    for (int i = 0; i < 2000; ++i) {
+        text += MakeLine(i);
+    }
+    std::string noise(5000, '\0');
+    std::uint32_t x = 12345;
+    for (char &c : noise) {
+        x = x * 1103515245u + 12345u;
+        c = static_cast<char>(x >> 24);
+    }
+    const std::string inputs[] = {text, noise, "a", "abcabcabcabcabcabc", std::string(70000, 'z')};
+    for (const std::string &input : inputs) {
+        std::vector<char> packed(Lz4CompressBound(input.size()));
+        const std::size_t packed_len = Lz4Compress(input.data(), input.size(), packed.data(), packed.size(), table.data());
+        assert(packed_len > 0);
+        std::vector<char> unpacked(input.size());
+        const std::size_t unpacked_len = Lz4Decompress(packed.data(), packed_len, unpacked.data(), unpacked.size());
+        assert(unpacked_len == input.size());
+        assert(std::memcmp(unpacked.data(), input.data(), input.size()) == 0);
+    }
+    {
+        std::vector<char> packed(Lz4CompressBound(text.size()));
+        const std::size_t packed_len = Lz4Compress(text.data(), text.size(), packed.data(), packed.size(), table.data());
+        assert(packed_len * 3 < text.size()); // log text compresses well
+        // Truncated input must be rejected, not overrun.
+        std::vector<char> unpacked(text.size());
+        assert(Lz4Decompress(packed.data(), packed_len / 2, unpacked.data(), unpacked.size()) == 0 ||
+               Lz4Decompress(packed.data(), packed_len / 2, unpacked.data(), unpacked.size()) < text.size());
+    }
+
+    // Sink round trip: every block decodes independently and in order.
+    const char *path = "compressed_sink_test.lllz";
+    std::string expected;
+    {
+        logger::CompressedSinkOptions options;
+        options.block_size = 8 * 1024;
+        options.block_count = 2;
+        logger::CompressedFileSink sink(path, options);
+        for (int i = 0; i < 5000; ++i) {
+            const std::string line = MakeLine(i);
+            sink.Write(line.data(), line.size());
+            expected += line;
+            if (i % 1000 == 999) {
+                sink.Flush();
+            }
+        }
+        sink.Flush();
+    }
+
+    logger::CompressedFileReader reader;
+    assert(reader.Open(path));
+    assert(reader.BlockCount() > 1);
+    std::vector<char> block(reader.BlockSize());
+    std::string decoded;
+    for (std::size_t b = 0; b < reader.BlockCount(); ++b) {
+        assert(reader.BlockRawOffset(b) == decoded.size());
+        const std::size_t len = reader.ReadBlock(b, block.data(), block.size());
+        assert(len > 0);
+        // Lines never straddle blocks.
+        assert(block[len - 1] == '\n');
+        decoded.append(block.data(), len);
+    }
+    assert(decoded == expected);
+
+    // Seeking straight to the last block works without touching earlier ones.
+    logger::CompressedFileReader seek_reader;
+    assert(seek_reader.Open(path));
+    assert(seek_reader.ReadBlock(seek_reader.BlockCount() - 1, block.data(), block.size()) > 0);
+
+    // A corrupt footer or index entry fails Open() instead of sizing buffers from it.
+    const std::uint64_t index_offset = ReadLe64At(path, -static_cast<long>(logger::CompressedFileSink::kFooterSize));
+    {
+        PatchLe64At(path, -static_cast<long>(logger::CompressedFileSink::kFooterSize) + 8, ~std::uint64_t{0} >> 4);
+        logger::CompressedFileReader corrupt;
+        assert(!corrupt.Open(path));
+        PatchLe64At(path, -static_cast<long>(logger::CompressedFileSink::kFooterSize) + 8, reader.BlockCount());
+        assert(corrupt.Open(path));
+    }
+    {
+        // raw_len, stored_len of the first index entry: the stored length runs far past the index.
+        PatchLe64At(path, static_cast<long>(index_offset) + 16, std::uint64_t{0xFFFFFFFF} << 32);
+        logger::CompressedFileReader corrupt;
+        assert(!corrupt.Open(path));
+    }
+
+    std::remove(path);
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include "../include/context.h"
+#include "../include/formatter.h"
+#include "../include/logger.h"
+#include "test_sinks.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace {
+
+using logger_test::StringSink;
+
+// Context records sent down the ring per context version (none when records carry no context).
+constexpr std::size_t kPerVersion = LOGGER_ENABLE_CONTEXT ? 1 : 0;
+
+std::string LineWith(const std::string &text, const char *message) {
+    const std::size_t at = text.find(message);
+    assert(at != std::string::npos);
+    const std::size_t begin = text.rfind('\n', at);
+    return text.substr(begin == std::string::npos ? 0 : begin + 1, text.find('\n', at) - (begin + 1));
+}
+
+} // namespace
+
+int main() {
+    // Every push and pop versions the stack; an empty stack is version 0.
+    logger::LogContext &context = logger::LogContext::Current();
+    assert(context.Version() == 0 && context.Depth() == 0);
+    {
+        LLL_CONTEXT("order", -42);
+        const std::uint64_t outer = context.Version();
+        assert(outer != 0);
+        {
+            LLL_CONTEXT("venue", "XNAS");
+            assert(context.Version() != outer);
+            assert(std::string(context.Text(), context.Length()) == "order=-42 venue=XNAS");
+        }
+        assert(context.Version() != outer && context.Depth() == 1);
+        assert(std::string(context.Text(), context.Length()) == "order=-42");
+    }
+    assert(context.Version() == 0 && context.Length() == 0);
+
+    // Stack depth is bounded; a rejected push does not pop on scope exit.
+    for (int i = 0; i < LOGGER_MAX_CONTEXT_DEPTH; ++i) {
+        assert(context.Push("k", static_cast<std::int64_t>(i)));
+    }
+    {
+        LLL_CONTEXT("overflow", 1);
+        assert(context.Depth() == LOGGER_MAX_CONTEXT_DEPTH);
+    }
+    assert(context.Depth() == LOGGER_MAX_CONTEXT_DEPTH);
+    for (int i = 0; i < LOGGER_MAX_CONTEXT_DEPTH; ++i) {
+        context.Pop();
+    }
+
+    // The context text travels down the ring once per version, not once per record.
+    logger::TextFormatter formatter;
+    StringSink sink;
+    {
+        auto log = std::make_unique<logger::Logger<256>>(formatter, sink);
+        assert(log->Info("before") == logger::LogResult::Success);
+        assert(log->PendingCount() == 1);
+        {
+            LLL_CONTEXT("order", 1234);
+            LLL_CONTEXT("venue", "XNAS");
+            for (int i = 0; i < 100; ++i) {
+                assert(log->LogFormat(logger::Level::Info, "fill %d", i) == logger::LogResult::Success);
+            }
+            assert(log->PendingCount() == 1 + kPerVersion + 100);
+            {
+                LLL_CONTEXT("leg", 2);
+                assert(log->Info("leg accepted") == logger::LogResult::Success);
+            }
+            assert(log->Info("order done") == logger::LogResult::Success);
+            assert(log->PendingCount() == 101 + 3 * kPerVersion + 2);
+        }
+        assert(log->Info("after") == logger::LogResult::Success);
+        assert(log->PendingCount() == 101 + 3 * kPerVersion + 3);
+
+        // Another thread's context is its own.
+        std::thread other([&] {
+            LLL_CONTEXT("session", "B");
+            assert(log->Info("from other thread") == logger::LogResult::Success);
+        });
+        other.join();
+        log->Start();
+    }
+
+    assert(LineWith(sink.bytes, "before").find('[' + std::string("order")) == std::string::npos);
+#if LOGGER_ENABLE_CONTEXT
+    assert(LineWith(sink.bytes, "fill 99").find("[order=1234 venue=XNAS] fill 99") != std::string::npos);
+    assert(LineWith(sink.bytes, "leg accepted").find("[order=1234 venue=XNAS leg=2] leg accepted") !=
+           std::string::npos);
+    assert(LineWith(sink.bytes, "order done").find("[order=1234 venue=XNAS] order done") != std::string::npos);
+    assert(LineWith(sink.bytes, "from other thread").find("[session=B] from other thread") != std::string::npos);
+#else
+    // The stack still works, but records carry no context and print none.
+    assert(sink.bytes.find("order=") == std::string::npos && sink.bytes.find("session=") == std::string::npos);
+#endif
+    assert(LineWith(sink.bytes, "after").find("order=") == std::string::npos);
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include "../include/sink.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+const char kLine[] = "[1000] [INFO] durable audit line\n";
+constexpr std::size_t kLineLen = sizeof(kLine) - 1;
+
+// Wait (bounded) until the sync thread reports `bytes` as durable.
+bool WaitSynced(const logger::FileSink &sink, std::uint64_t bytes) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (sink.Stats().synced_bytes < bytes) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    char path[64];
+    std::snprintf(path, sizeof(path), "/tmp/lll_durability_test_%ld.log",
+                  static_cast<long>(std::chrono::steady_clock::now().time_since_epoch().count() % 1000000));
+
+    // None: no sync thread, no syncs.
+    {
+        logger::FileSink sink(path, "wb");
+        sink.Write(kLine, kLineLen);
+        sink.OnSevere(logger::Level::Fatal);
+        sink.Flush();
+        assert(sink.Stats().syncs == 0);
+    }
+
+    // SyncOnError: plain writes and flushes never sync; an Error record does.
+    {
+        logger::DurabilityPolicy policy;
+        policy.mode = logger::DurabilityPolicy::Mode::SyncOnError;
+        logger::FileSink sink(path, "wb", policy);
+        for (int i = 0; i < 100; ++i) {
+            sink.Write(kLine, kLineLen);
+        }
+        sink.Flush();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        assert(sink.Stats().syncs == 0);
+
+        sink.OnSevere(logger::Level::Error);
+        assert(WaitSynced(sink, 100 * kLineLen));
+        const logger::SyncStats stats = sink.Stats();
+        assert(stats.syncs == 1 && stats.failures == 0);
+        assert(stats.max_ns >= stats.last_ns && stats.total_ns >= stats.last_ns);
+    }
+
+    // Periodic by bytes: syncs keep up with the write stream.
+    {
+        logger::DurabilityPolicy policy;
+        policy.mode = logger::DurabilityPolicy::Mode::Periodic;
+        policy.interval_ms = 0;
+        policy.interval_bytes = 4096;
+        logger::FileSink sink(path, "wb", policy);
+        for (int i = 0; i < 1000; ++i) {
+            sink.Write(kLine, kLineLen);
+        }
+        assert(WaitSynced(sink, 1000 * kLineLen - 4096));
+        assert(sink.Stats().syncs >= 1);
+    }
+
+    // Periodic by time: the sync thread flushes and syncs buffered data with no further writes.
+    {
+        logger::DurabilityPolicy policy;
+        policy.mode = logger::DurabilityPolicy::Mode::Periodic;
+        policy.interval_ms = 2;
+        logger::FileSink sink(path, "wb", policy);
+        sink.Write(kLine, kLineLen);
+        assert(WaitSynced(sink, kLineLen));
+        assert(sink.Stats().syncs >= 1);
+
+        // Already in the file while the sink (and its stdio buffer) is still open.
+        std::FILE *file = std::fopen(path, "rb");
+        assert(file);
+        char buffer[256];
+        const std::size_t n = std::fread(buffer, 1, sizeof(buffer), file);
+        std::fclose(file);
+        assert(n == kLineLen && std::memcmp(buffer, kLine, kLineLen) == 0);
+    }
+
+    // Destruction makes everything durable and the file holds every byte.
+    {
+        logger::DurabilityPolicy policy;
+        policy.mode = logger::DurabilityPolicy::Mode::SyncOnError;
+        {
+            logger::FileSink sink(path, "wb", policy);
+            for (int i = 0; i < 10; ++i) {
+                sink.Write(kLine, kLineLen);
+            }
+        }
+        std::FILE *file = std::fopen(path, "rb");
+        assert(file);
+        char buffer[1024];
+        const std::size_t n = std::fread(buffer, 1, sizeof(buffer), file);
+        std::fclose(file);
+        assert(n == 10 * kLineLen);
+        assert(std::memcmp(buffer + 9 * kLineLen, kLine, kLineLen) == 0);
+    }
+
+    std::remove(path);
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include "../include/flush_policy.h"
+
+#include <cassert>
+#include <chrono>
+#include <thread>
+
+int main() {
+    using logger::FlushController;
+    using logger::FlushPolicy;
+    using logger::Level;
+
+    // Eager: flush whenever the ring runs empty with output pending.
+    {
+        FlushController flush(FlushPolicy::Eager());
+        assert(!flush.OnIdle());
+        assert(!flush.OnWrite(100, Level::Info));
+        assert(flush.OnIdle());
+        flush.OnFlushed();
+        assert(!flush.OnIdle());
+        assert(flush.OnWrite(100, Level::Error));
+    }
+
+    // Batched by size: idle polls do not flush young output.
+    {
+        FlushPolicy policy;
+        policy.max_bytes = 1000;
+        policy.max_delay_us = 0;
+        FlushController flush(policy);
+        for (int i = 0; i < 9; ++i) {
+            assert(!flush.OnWrite(100, Level::Info));
+            assert(!flush.OnIdle());
+        }
+        assert(flush.OnWrite(100, Level::Info));
+        flush.OnFlushed();
+        assert(flush.PendingBytes() == 0);
+        assert(!flush.OnWrite(0, Level::Fatal)); // filtered record produced nothing
+    }
+
+    // Batched by age: the oldest unflushed byte bounds the delay.
+    {
+        FlushPolicy policy;
+        policy.max_bytes = 0;
+        policy.max_delay_us = 2000;
+        FlushController flush(policy);
+        assert(!flush.OnWrite(10, Level::Info));
+        assert(!flush.OnIdle());
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        assert(flush.OnIdle());
+    }
+
+    // Error records flush immediately unless disabled.
+    {
+        FlushPolicy policy;
+        FlushController flush(policy);
+        assert(!flush.OnWrite(10, Level::Warn));
+        assert(flush.OnWrite(10, Level::Error));
+
+        policy.flush_on_error = false;
+        FlushController quiet(policy);
+        assert(!quiet.OnWrite(10, Level::Fatal));
+    }
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+#include "../include/formatter.h"
+#include "../include/histogram.h"
+#include "../include/logger.h"
+#include "test_sinks.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using logger_test::StringSink;
+
+logger::HistogramRegistry registry;
+
+void RecordLatency(std::uint64_t ns) {
+    LLL_HISTOGRAM_RECORD(registry, logger::Level::Info, "order_ack_ns", ns);
+}
+
+// Sum of "n=" over every summary line of `name`.
+std::uint64_t TotalSamples(const std::string &text, const std::string &name, std::size_t &lines) {
+    std::uint64_t total = 0;
+    lines = 0;
+    const std::string needle = name + " n=";
+    for (std::size_t at = text.find(needle); at != std::string::npos; at = text.find(needle, at + 1)) {
+        total += std::strtoull(text.c_str() + at + needle.size(), nullptr, 10);
+        ++lines;
+    }
+    return total;
+}
+
+} // namespace
+
+int main() {
+    using logger::LogLinearHistogram;
+
+    // Buckets are contiguous and each value falls inside its bucket's bounds.
+    for (std::size_t bucket = 1; bucket < LogLinearHistogram::kBucketCount; ++bucket) {
+        assert(LogLinearHistogram::BucketLow(bucket) == LogLinearHistogram::BucketHigh(bucket - 1) + 1);
+    }
+    assert(LogLinearHistogram::BucketHigh(LogLinearHistogram::kBucketCount - 1) == ~std::uint64_t{0});
+    for (std::uint64_t value : {0ull, 15ull, 16ull, 1000ull, 123456789ull, ~0ull}) {
+        const std::size_t bucket = LogLinearHistogram::BucketOf(value);
+        assert(LogLinearHistogram::BucketLow(bucket) <= value && value <= LogLinearHistogram::BucketHigh(bucket));
+    }
+
+    // Percentiles land within one bucket (1/16) of the exact value.
+    auto data = std::make_unique<LogLinearHistogram>();
+    for (std::uint64_t v = 1; v <= 10000; ++v) {
+        data->Record(v);
+    }
+    assert(data->Count() == 10000 && data->Min() == 1 && data->Max() == 10000);
+    const std::uint64_t p50 = data->Percentile(0.5);
+    const std::uint64_t p99 = data->Percentile(0.99);
+    assert(p50 > 5000 - 5000 / 16 && p50 < 5000 + 5000 / 16);
+    assert(p99 > 9900 - 9900 / 16 && p99 <= 10000);
+
+    // Producer threads record; the consumer writes one summary per interval.
+    constexpr int kThreads = 3;
+    constexpr std::uint64_t kPerThread = 200000;
+    logger::TextFormatter formatter;
+    StringSink sink;
+    {
+        auto log = std::make_unique<logger::Logger<64>>(formatter, sink);
+        log->AttachHistograms(registry, 10);
+        log->Start();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t) {
+            threads.emplace_back([] {
+                for (std::uint64_t i = 0; i < kPerThread; ++i) {
+                    RecordLatency(100 + i % 900);
+                    if (i % 20000 == 0) {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(3));
+                    }
+                }
+            });
+        }
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+        // The consumer thread harvests every interval on its own, before Stop().
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        std::size_t periodic = 0;
+        while (periodic < kThreads * kPerThread && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            std::size_t periodic_lines = 0;
+            periodic = TotalSamples(sink.Snapshot(), "order_ack_ns", periodic_lines);
+            assert(periodic_lines < 1000);
+            if (periodic == kThreads * kPerThread) {
+                assert(periodic_lines >= 2);
+            }
+        }
+        assert(periodic == kThreads * kPerThread);
+    } // Stop() harvests the last interval (empty here)
+
+    // Every sample is reported exactly once, in a handful of records rather than 600k.
+    std::size_t lines = 0;
+    assert(TotalSamples(sink.bytes, "order_ack_ns", lines) == kThreads * kPerThread);
+    assert(lines >= 1 && lines < 1000);
+    assert(sink.bytes.find("min=100 ") != std::string::npos);
+    assert(sink.bytes.find("max=999 ") != std::string::npos);
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include "../include/formatter.h"
+#include "../include/logger.h"
+#include "test_sinks.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using logger_test::StringSink;
+
+// Parse the hex columns of every dump line back into bytes, checking offsets are continuous.
+std::vector<unsigned char> Undump(const std::string &text) {
+    std::vector<unsigned char> bytes;
+    std::istringstream lines(text);
+    std::string line;
+    while (std::getline(lines, line)) {
+        if (line.compare(0, 2, "  ") != 0 || line.size() < 12 || line[10] != ':') {
+            continue;
+        }
+        assert(std::strtoul(line.substr(2, 8).c_str(), nullptr, 16) == bytes.size());
+        for (std::size_t i = 0; i < 16; ++i) {
+            const std::size_t at = 12 + (i / 2) * 5 + (i % 2) * 2;
+            if (line[at] == ' ') {
+                break;
+            }
+            bytes.push_back(static_cast<unsigned char>(std::strtoul(line.substr(at, 2).c_str(), nullptr, 16)));
+        }
+    }
+    return bytes;
+}
+
+} // namespace
+
+int main() {
+    // One short line: hex groups, padding and the ASCII column.
+    logger::LogRecord record{};
+    record.level = logger::Level::Info;
+    record.kind = logger::RecordKind::Binary;
+    const char packet[] = "Hello world\n\x00\xff\x7f!";
+    record.SetBinaryChunk("pkt", 3, packet, sizeof(packet) - 1, 0, sizeof(packet) - 1);
+    char text[logger::kFormatScratchSize];
+    logger::TextFormatter formatter;
+    const std::size_t len = formatter.FormatRecord(record, text, sizeof(text));
+    const std::string dump(text, len);
+    assert(dump.find(" pkt (16 bytes)\n") != std::string::npos);
+    assert(dump.find("  00000000: 4865 6c6c 6f20 776f 726c 640a 00ff 7f21  Hello world....!\n") != std::string::npos);
+    assert(dump.back() == '\n');
+
+    // Large payloads span several records and read back as one dump.
+    std::vector<unsigned char> payload(10000);
+    for (std::size_t i = 0; i < payload.size(); ++i) {
+        payload[i] = static_cast<unsigned char>((i * 131) ^ (i >> 8));
+    }
+    StringSink sink;
+    {
+        auto log = std::make_unique<logger::Logger<64>>(formatter, sink);
+        assert(log->LogBinary(logger::Level::Debug, payload.data(), payload.size(), "md_packet") ==
+               logger::LogResult::Success);
+        const std::size_t chunks = log->PendingCount();
+        assert(chunks == (payload.size() + logger::LogRecord::BinaryChunkCapacity(9) - 1) /
+                             logger::LogRecord::BinaryChunkCapacity(9));
+
+        // All chunks or none: a payload that cannot fit the free slots is dropped whole.
+        std::vector<unsigned char> huge(64 * 1024);
+        assert(log->LogBinary(logger::Level::Debug, huge.data(), huge.size(), "huge") == logger::LogResult::BufferFull);
+        assert(log->PendingCount() == chunks);
+
+        assert(log->LogBinary(logger::Level::Debug, nullptr, 0, "empty") == logger::LogResult::Success);
+        log->Start();
+    }
+    assert(sink.bytes.find(" md_packet (10000 bytes)\n") != std::string::npos);
+    assert(sink.bytes.find(" empty (0 bytes)\n") != std::string::npos);
+    assert(sink.bytes.find("huge") == std::string::npos);
+    assert(Undump(sink.bytes) == payload);
+    return 0;
+}
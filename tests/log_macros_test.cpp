@@ -0,0 +1,79 @@
+#include "../include/formatter.h"
+#include "../include/logger.h"
+#include "test_sinks.h"
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace {
+
+using logger_test::StringSink;
+
+// A whole message, preceded by the function name when the call site is recorded.
+std::string Tail(const char *message) {
+    return std::string(LOGGER_ENABLE_SOURCE_LOCATION ? " main " : " ") + message + '\n';
+}
+
+int evaluations = 0;
+
+int Expensive(int value) {
+    ++evaluations;
+    return value;
+}
+
+} // namespace
+
+int main() {
+    logger::TextFormatter formatter;
+    StringSink sink;
+    {
+        auto log = std::make_unique<logger::Logger<64>>(formatter, sink);
+        log->SetLevel(logger::Level::Info);
+
+        // Filtered levels never evaluate their arguments.
+        LLL_TRACE(*log, "trace %d", Expensive(1));
+        LLL_DEBUG(*log, "debug %d", Expensive(2));
+        LLL_LOG(*log, logger::Level::Debug, "dynamic %d", Expensive(3));
+        assert(evaluations == 0);
+        assert(log->PendingCount() == 0);
+
+        LLL_INFO(*log, "info %d", Expensive(4));
+        LLL_ERROR(*log, "error %d", Expensive(5));
+        LLL_FATAL(*log, "no arguments");
+#if LOGGER_COMPILE_TIME_MIN_LEVEL <= 2
+        assert(evaluations == 2);
+        assert(log->PendingCount() == 3);
+#endif
+
+        // The runtime threshold is re-read on every call.
+        log->SetLevel(logger::Level::Trace);
+        LLL_DEBUG(*log, "debug %d", Expensive(6));
+        LLL_WARN(*log, "warn %d", Expensive(7));
+#if LOGGER_COMPILE_TIME_MIN_LEVEL == 0
+        assert(evaluations == 4);
+        assert(log->PendingCount() == 5);
+#endif
+        log->Start();
+    }
+
+    assert(sink.bytes.find("trace 1") == std::string::npos);
+    assert(sink.bytes.find("debug 2") == std::string::npos);
+    assert(sink.bytes.find("dynamic 3") == std::string::npos);
+#if LOGGER_ENABLE_SOURCE_LOCATION
+    assert(sink.bytes.find(" log_macros_test.cpp:") != std::string::npos);
+#endif
+    assert(sink.bytes.find(Tail("error 5")) != std::string::npos);
+    assert(sink.bytes.find(Tail("no arguments")) != std::string::npos);
+    assert(sink.bytes.find(Tail("warn 7")) != std::string::npos);
+#if LOGGER_COMPILE_TIME_MIN_LEVEL == 0
+    assert(sink.bytes.find(Tail("debug 6")) != std::string::npos);
+#else
+    // Below the compile-time floor: compiled out even though the runtime level allows it.
+    assert(sink.bytes.find("debug 6") == std::string::npos);
+    assert(sink.bytes.find("info 4") == std::string::npos);
+    assert(evaluations == 2);
+#endif
+    return 0;
+}
@@ -0,0 +1,112 @@
+#include "../include/formatter.h"
+#include "../include/logger.h"
+#include "test_sinks.h"
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace {
+
+using logger_test::HasLine;
+using logger_test::StringSink;
+
+// Distinct text at every offset, so a misplaced continuation slot shows up.
+std::string Pattern(char tag, std::size_t length) {
+    std::string text;
+    for (std::size_t i = 0; text.size() < length; ++i) {
+        text += tag + std::to_string(i) + ' ';
+    }
+    text.resize(length);
+    return text;
+}
+
+} // namespace
+
+int main() {
+    constexpr std::size_t kSlot = LOGGER_MAX_MESSAGE_SIZE;
+    static_assert(logger::LogRecord::ContinuationsFor(kSlot - 1) == 0, "a full first slot needs no continuation");
+    static_assert(logger::LogRecord::ContinuationsFor(kSlot) == 1, "one byte more needs one");
+    static_assert(logger::LogRecord::ContinuationsFor(logger::kMaxSpannedMessageSize) == LOGGER_MAX_RECORD_SPAN - 1,
+                  "the longest message fills the span");
+
+    const std::string fix = Pattern('a', 16000);
+    const std::string formatted = Pattern('b', 5000);
+    const std::string exact = Pattern('c', kSlot - 1);
+    const std::string huge = Pattern('d', logger::kMaxSpannedMessageSize + 500);
+    const std::string cut = Pattern('e', 3000);
+
+    logger::TextFormatter formatter;
+    StringSink sink;
+    {
+        auto log = std::make_unique<logger::Logger<64>>(formatter, sink);
+#if LOGGER_MAX_RECORD_SPAN > 1
+        assert(log->Info(fix.c_str()) == logger::LogResult::Success);
+        assert(log->PendingCount() == 1 + 16000 / kSlot);
+
+        assert(log->LogFormat(logger::Level::Warn, "%s|%d", formatted.c_str(), 7) == logger::LogResult::Success);
+        assert(log->PendingCount() == 16 + 1 + 5002 / kSlot);
+
+        assert(log->Info(exact.c_str()) == logger::LogResult::Success);
+        assert(log->PendingCount() == 22);
+
+        // Past the span the message is cut, not dropped.
+        assert(log->Info(huge.c_str()) == logger::LogResult::Success);
+        assert(log->PendingCount() == 22 + LOGGER_MAX_RECORD_SPAN);
+
+        log->SetLongMessagePolicy(logger::LongMessagePolicy::Truncate);
+        assert(log->Info(cut.c_str()) == logger::LogResult::Success);
+        assert(log->PendingCount() == 39);
+#else
+        // No continuation slots: every message takes one slot and is cut to fit it,
+        // whatever policy is asked for.
+        log->SetLongMessagePolicy(logger::LongMessagePolicy::Span);
+        assert(log->Info(fix.c_str()) == logger::LogResult::Success);
+        assert(log->LogFormat(logger::Level::Warn, "%s|%d", formatted.c_str(), 7) == logger::LogResult::Success);
+        assert(log->Info(exact.c_str()) == logger::LogResult::Success);
+        assert(log->Info(huge.c_str()) == logger::LogResult::Success);
+        assert(log->Info(cut.c_str()) == logger::LogResult::Success);
+        assert(log->PendingCount() == 5);
+#endif
+
+        log->Start();
+    }
+#if LOGGER_MAX_RECORD_SPAN > 1
+    assert(HasLine(sink.bytes, fix));
+    assert(HasLine(sink.bytes, formatted + "|7"));
+    assert(HasLine(sink.bytes, huge.substr(0, logger::kMaxSpannedMessageSize)));
+#else
+    assert(HasLine(sink.bytes, fix.substr(0, kSlot - 1)));
+    assert(HasLine(sink.bytes, formatted.substr(0, kSlot - 1)));
+    assert(HasLine(sink.bytes, huge.substr(0, kSlot - 1)));
+#endif
+    assert(HasLine(sink.bytes, exact));
+    assert(HasLine(sink.bytes, cut.substr(0, kSlot - 1)));
+
+    // A spanning message is enqueued whole or not at all.
+    StringSink small_sink;
+    {
+        auto log = std::make_unique<logger::Logger<16>>(formatter, small_sink);
+#if LOGGER_MAX_RECORD_SPAN > 1
+        assert(log->Info(fix.c_str()) == logger::LogResult::BufferFull);
+        assert(log->PendingCount() == 0);
+        assert(log->Info("short") == logger::LogResult::Success);
+        assert(log->Info(Pattern('f', 14 * kSlot).c_str()) == logger::LogResult::BufferFull);
+        assert(log->Info(Pattern('g', 13 * kSlot).c_str()) == logger::LogResult::Success);
+        assert(log->PendingCount() == 15);
+        assert(log->DroppedCount() == 2); // a rejected spanning message counts once
+#else
+        assert(log->Info(fix.c_str()) == logger::LogResult::Success);
+        assert(log->Info("short") == logger::LogResult::Success);
+        assert(log->PendingCount() == 2 && log->DroppedCount() == 0);
+#endif
+        log->Start();
+    }
+    assert(HasLine(small_sink.bytes, "short"));
+#if LOGGER_MAX_RECORD_SPAN > 1
+    assert(HasLine(small_sink.bytes, Pattern('g', 13 * kSlot)));
+    assert(small_sink.bytes.find("f0 ") == std::string::npos);
+#endif
+    return 0;
+}
@@ -0,0 +1,147 @@
+#include "../include/memory_sink.h"
+
+#include <atomic>
+#include <cassert>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+namespace {
+
+std::string ReadFile(const char *path) {
+    std::string out;
+    std::FILE *file = std::fopen(path, "rb");
+    assert(file);
+    char buffer[4096];
+    std::size_t n;
+    while ((n = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        out.append(buffer, n);
+    }
+    std::fclose(file);
+    return out;
+}
+
+volatile std::sig_atomic_t g_counted_signals = 0;
+
+extern "C" void CountSignal(int) {
+    g_counted_signals = g_counted_signals + 1;
+}
+
+void WriteLine(logger::MemoryRingSink &sink, long number) {
+    char line[64];
+    const int n = std::snprintf(line, sizeof(line), "line %08ld payload\n", number);
+    sink.Write(line, static_cast<std::size_t>(n));
+}
+
+// Every line must be intact and numbers consecutive, except across a lap marker.
+// Returns the number of lines seen.
+long CheckDump(const std::string &dump) {
+    long lines = 0;
+    long previous = -1;
+    std::size_t start = 0;
+    while (start < dump.size()) {
+        const std::size_t end = dump.find('\n', start);
+        assert(end != std::string::npos);
+        const std::string line = dump.substr(start, end - start);
+        start = end + 1;
+        if (line.empty() || line.rfind("[LOGGER]", 0) == 0) {
+            previous = -1;
+            continue;
+        }
+        long number = 0;
+        char tail[16];
+        assert(std::sscanf(line.c_str(), "line %ld %15s", &number, tail) == 2);
+        assert(std::strcmp(tail, "payload") == 0);
+        assert(previous < 0 || number == previous + 1);
+        previous = number;
+        ++lines;
+    }
+    return lines;
+}
+
+} // namespace
+
+int main() {
+    char base[64];
+    std::snprintf(base, sizeof(base), "/tmp/lll_memory_test_%d", static_cast<int>(::getpid()));
+    char path[96];
+    std::snprintf(path, sizeof(path), "%s.dump", base);
+
+    // Wrap-around keeps only the newest complete lines.
+    {
+        logger::MemoryRingSink sink(1000);
+        for (long i = 0; i < 500; ++i) {
+            WriteLine(sink, i);
+        }
+        assert(sink.DumpTo(path));
+        const std::string dump = ReadFile(path);
+        assert(dump.size() <= 1000);
+        assert(CheckDump(dump) > 0);
+        assert(dump.find("line 00000499 payload\n") == dump.size() - 22);
+    }
+
+    // Dumps taken concurrently with writes never contain torn lines.
+    {
+        logger::MemoryRingSink sink(64 * 1024);
+        std::atomic<bool> done{false};
+        std::thread writer([&] {
+            for (long i = 0; i < 2000000; ++i) {
+                WriteLine(sink, i);
+            }
+            done.store(true);
+        });
+        int dumps = 0;
+        while (!done.load() || dumps == 0) {
+            assert(sink.DumpTo(path));
+            CheckDump(ReadFile(path));
+            ++dumps;
+        }
+        writer.join();
+    }
+
+    // Triggers: a Fatal record and a signal both produce "<base>.<n>" files.
+    {
+        logger::MemoryRingSink sink(4096, base);
+        WriteLine(sink, 1);
+        sink.OnSevere(logger::Level::Error);
+        assert(sink.TriggeredDumps() == 0);
+        sink.OnSevere(logger::Level::Fatal);
+        assert(sink.TriggeredDumps() == 1);
+
+        assert(sink.InstallDumpSignal(SIGUSR1));
+        std::raise(SIGUSR1);
+        WriteLine(sink, 2);
+        assert(sink.TriggeredDumps() == 2);
+
+        char dump[96];
+        std::snprintf(dump, sizeof(dump), "%s.0", base);
+        assert(ReadFile(dump) == "line 00000001 payload\n");
+        std::remove(dump);
+        std::snprintf(dump, sizeof(dump), "%s.1", base);
+        assert(ReadFile(dump) == "line 00000001 payload\n");
+        std::remove(dump);
+        std::signal(SIGUSR1, SIG_DFL);
+    }
+
+    // A destroyed sink gives the signal back to the previous handler; raising it is safe.
+    {
+        std::signal(SIGUSR2, CountSignal);
+        {
+            logger::MemoryRingSink sink(4096, base);
+            assert(sink.InstallDumpSignal(SIGUSR2));
+            std::raise(SIGUSR2);
+            assert(g_counted_signals == 0);
+        }
+        std::raise(SIGUSR2);
+        assert(g_counted_signals == 1);
+        std::signal(SIGUSR2, SIG_DFL);
+    }
+
+    std::remove(path);
+    return 0;
+}
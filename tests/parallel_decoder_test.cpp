@@ -0,0 +1,81 @@
+#include "../include/binary_log.h"
+#include "../include/logger.h"
+#include "../include/parallel_decoder.h"
+#include "../include/router.h"
+#include "test_sinks.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+namespace {
+
+using logger_test::StringSink;
+
+constexpr const char *kPath = "/tmp/lll_parallel_decoder_test.lllb";
+
+} // namespace
+
+int main() {
+    // The same records, rendered live by TextFormatter and stored by BinaryFormatter.
+    StringSink live;
+    {
+        logger::TextFormatter text;
+        logger::BinaryFormatter binary;
+        logger::BinaryFileSink file(kPath, 4096);
+        const logger::Destination destinations[] = {
+            {&text, &live, logger::Level::Trace},
+            {&binary, &file, logger::Level::Trace},
+        };
+        auto instance = std::make_unique<logger::Logger<8192>>(destinations, 2);
+        for (int n = 0; n < 5000; ++n) {
+            const logger::Level level = static_cast<logger::Level>(n % logger::kLevelCount);
+            assert(instance->LogFormat(level, "fill id=%d px=%d.%02d%s", n, n % 997, n % 100,
+                                       n % 1000 == 0 ? "\nsecond line" : "") == logger::LogResult::Success);
+        }
+        // Binary payloads are stored raw and dumped by the decoder exactly as live.
+        unsigned char packet[3000];
+        for (std::size_t i = 0; i < sizeof(packet); ++i) {
+            packet[i] = static_cast<unsigned char>(i * 7);
+        }
+        assert(instance->LogBinary(logger::Level::Info, packet, sizeof(packet), "packet") == logger::LogResult::Success);
+        instance->Start();
+        instance.reset();
+    }
+    const std::uint64_t packet_records = (3000 + logger::LogRecord::BinaryChunkCapacity(6) - 1) /
+                                         logger::LogRecord::BinaryChunkCapacity(6);
+
+    logger::BinaryLogReader reader;
+    assert(reader.Open(kPath));
+    assert(reader.BlockCount() > 20);
+
+    // Output is byte-identical to the live formatter whatever the thread and slot counts.
+    const logger::DecodeOptions configurations[] = {{1, 1}, {3, 2}, {4, 0}};
+    for (const logger::DecodeOptions &options : configurations) {
+        StringSink decoded;
+        logger::ParallelDecoder decoder(options);
+        const logger::DecodeStats stats = decoder.Decode(reader, decoded);
+        assert(stats.blocks == reader.BlockCount() && stats.corrupt_blocks == 0);
+        assert(stats.records == 5000 + packet_records);
+        assert(stats.output_bytes == decoded.bytes.size());
+        assert(decoded.writes == reader.BlockCount());
+        assert(decoded.bytes == live.bytes);
+    }
+
+    // A sub-range decodes exactly those blocks.
+    StringSink partial;
+    logger::ParallelDecoder decoder(logger::DecodeOptions{2, 0});
+    const logger::DecodeStats stats = decoder.Decode(reader, partial, 5, 9);
+    assert(stats.blocks == 4);
+    std::string expected;
+    std::uint64_t records = 0;
+    for (std::size_t block = 5; block < 9; ++block) {
+        assert(logger::ParallelDecoder::RenderBlock(reader, block, expected, records));
+    }
+    assert(partial.bytes == expected && stats.records == records);
+
+    std::remove(kPath);
+    return 0;
+}
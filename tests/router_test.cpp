@@ -0,0 +1,94 @@
+#include "../include/formatter.h"
+#include "../include/level.h"
+#include "../include/record.h"
+#include "../include/router.h"
+#include "../include/sink.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+
+namespace {
+
+// Counts records formatted so fan-out can be checked for single formatting.
+class CountingFormatter final : public logger::Formatter {
+  public:
+    std::size_t FormatRecord(const logger::LogRecord &record, char *buffer, std::size_t capacity) override {
+        ++calls;
+        return inner.FormatRecord(record, buffer, capacity);
+    }
+    logger::TextFormatter inner;
+    int calls = 0;
+};
+
+// Records how many lines were written and flushes requested.
+class CaptureSink final : public logger::Sink {
+  public:
+    void Write(const char *data, std::size_t len) override {
+        ++writes;
+        last_len = len;
+        std::memcpy(last, data, len < sizeof(last) ? len : sizeof(last) - 1);
+    }
+    void Flush() override { ++flushes; }
+    int writes = 0;
+    int flushes = 0;
+    std::size_t last_len = 0;
+    char last[512] = {};
+};
+
+logger::LogRecord MakeRecord(logger::Level level) {
+    logger::LogRecord record{};
+    record.level = level;
+    record.SetMessage("routed");
+    return record;
+}
+
+} // namespace
+
+int main() {
+    CountingFormatter text;
+    CountingFormatter archive_format;
+    CaptureSink file;
+    CaptureSink console;
+    CaptureSink archive;
+
+    const logger::Destination destinations[] = {
+        {&text, &file, logger::Level::Info},
+        {&archive_format, &archive, logger::Level::Trace},
+        {&text, &console, logger::Level::Warn},
+    };
+    logger::Router router(destinations, 3);
+    assert(router.DestinationCount() == 3);
+
+    char scratch[1024];
+
+    // DEBUG only reaches the catch-all archive; text formatter is skipped.
+    (void)router.Dispatch(MakeRecord(logger::Level::Debug), scratch, sizeof(scratch));
+    assert(archive.writes == 1 && file.writes == 0 && console.writes == 0);
+    assert(text.calls == 0 && archive_format.calls == 1);
+
+    // INFO reaches file and archive.
+    (void)router.Dispatch(MakeRecord(logger::Level::Info), scratch, sizeof(scratch));
+    assert(archive.writes == 2 && file.writes == 1 && console.writes == 0);
+    assert(text.calls == 1);
+
+    // ERROR reaches all three, but the shared text formatter runs once.
+    const std::size_t total = router.Dispatch(MakeRecord(logger::Level::Error), scratch, sizeof(scratch));
+    assert(archive.writes == 3 && file.writes == 2 && console.writes == 1);
+    assert(text.calls == 2 && archive_format.calls == 3);
+    assert(total == file.last_len + console.last_len + archive.last_len);
+    assert(std::strstr(console.last, "[ERROR]") != nullptr);
+
+    // Each distinct sink is flushed exactly once.
+    router.Flush();
+    assert(file.flushes == 1 && console.flushes == 1 && archive.flushes == 1);
+
+    // Single destination: one format, one write, no level filtering.
+    CaptureSink only;
+    logger::Router single(text, only);
+    assert(single.DestinationCount() == 1);
+    (void)single.Dispatch(MakeRecord(logger::Level::Trace), scratch, sizeof(scratch));
+    assert(only.writes == 1);
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include "../include/formatter.h"
+#include "../include/logger.h"
+#include "../include/sampler.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+int main() {
+    // Deterministic 1-in-4 keeps the first call and then every fourth call.
+    logger::LevelSampler sampler;
+    sampler.Set(logger::Level::Trace, logger::SamplingMode::Deterministic, 4);
+    std::size_t kept = 0;
+    for (int i = 0; i < 100; ++i) {
+        std::uint32_t rate = 0;
+        if (sampler.Admit(logger::Level::Trace, rate)) {
+            assert(rate == 4);
+            assert(i % 4 == 0);
+            ++kept;
+        }
+    }
+    assert(kept == 25);
+
+    // Unsampled levels keep everything and report rate 1.
+    std::uint32_t info_rate = 0;
+    assert(sampler.Admit(logger::Level::Info, info_rate));
+    assert(info_rate == 1);
+
+    // Random 1-in-10 should land near 10% over many calls.
+    logger::SamplePoint point(logger::SamplingMode::Random, 10);
+    std::size_t random_kept = 0;
+    for (int i = 0; i < 100000; ++i) {
+        if (point.Admit()) {
+            ++random_kept;
+        }
+    }
+    assert(random_kept > 8000 && random_kept < 12000);
+    assert(point.Rate() == 10);
+
+    // Logger reports skipped calls without touching the ring.
+    logger::TextFormatter formatter;
+    logger::NullSink sink;
+    logger::Logger<16> log(formatter, sink);
+    log.SetSampling(logger::Level::Debug, logger::SamplingMode::Deterministic, 1000);
+    assert(log.Log(logger::Level::Debug, "kept") == logger::LogResult::Success);
+    assert(log.Log(logger::Level::Debug, "skipped") == logger::LogResult::Sampled);
+    assert(log.PendingCount() == 1);
+
+    // Sampled records carry their rate into the formatted output.
+    logger::LogRecord record{};
+    record.level = logger::Level::Trace;
+    record.sample_rate = 4;
+    record.SetMessage("tick");
+    char buffer[256];
+    const std::size_t written = formatter.FormatRecord(record, buffer, sizeof(buffer));
+    assert(written > 0);
+    assert(std::strstr(buffer, "[sample=1/4]") != nullptr);
+
+    return 0;
+}
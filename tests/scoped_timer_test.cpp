@@ -0,0 +1,94 @@
+#include "../include/formatter.h"
+#include "../include/logger.h"
+#include "../include/scoped_timer.h"
+#include "../internal/clock.h"
+#include "test_sinks.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace {
+
+using logger_test::StringSink;
+
+using TestLogger = logger::Logger<64>;
+
+void Fast(TestLogger &log) {
+    LLL_SCOPE_TIMER_OVER(log, logger::Level::Info, "fast", 50 * 1000 * 1000); // 50 ms: never reached
+}
+
+void Slow(TestLogger &log) {
+    LLL_SCOPE_TIMER_OVER(log, logger::Level::Info, "slow", 1000 * 1000); // 1 ms
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+}
+
+std::uint64_t DurationOf(const std::string &text, const char *name) {
+    const std::string needle = std::string(name) + " took ";
+    const std::size_t at = text.find(needle);
+    assert(at != std::string::npos);
+    return std::strtoull(text.c_str() + at + needle.size(), nullptr, 10);
+}
+
+} // namespace
+
+int main() {
+    // The consumer renders the TSC pair; the producer stores it unformatted.
+    logger::TextFormatter formatter;
+    logger::LogRecord record{};
+    record.level = logger::Level::Info;
+    record.kind = logger::RecordKind::ScopeTimer;
+    record.timestamp = 1000;
+    record.end_timestamp = 1000 + logger::internal::NanosecondsToTsc(2000000);
+    record.SetMessage("parse");
+    char line[logger::kFormatScratchSize];
+    assert(formatter.FormatRecord(record, line, sizeof(line)) > 0);
+    const std::uint64_t parse_ns = DurationOf(line, "parse");
+    assert(parse_ns > 1999000 && parse_ns < 2001000);
+
+    StringSink sink;
+    {
+        auto log = std::make_unique<TestLogger>(formatter, sink);
+
+        // Scopes under the threshold push nothing.
+        for (int i = 0; i < 100; ++i) {
+            Fast(*log);
+        }
+        assert(log->PendingCount() == 0);
+
+        Slow(*log);
+        assert(log->PendingCount() == 1);
+
+        // A filtered level neither reads the clock nor pushes.
+        log->SetLevel(logger::Level::Warn);
+        {
+            logger::ScopedTimer<TestLogger> timer(*log, "filtered", logger::Level::Info);
+        }
+        assert(log->PendingCount() == 1);
+        log->SetLevel(logger::Level::Trace);
+
+        {
+            LLL_SCOPE_TIMER(*log, logger::Level::Debug, "empty");
+        }
+        assert(log->PendingCount() == 2);
+
+        log->Start();
+    } // drains
+
+    // 5 ms sleep, with generous slack for a loaded machine.
+    const std::uint64_t slow_ns = DurationOf(sink.bytes, "slow");
+    assert(slow_ns >= 4000000 && slow_ns < 2000000000);
+    assert(sink.bytes.find("[INFO]") != std::string::npos);
+    assert(sink.bytes.find("[DEBUG]") != std::string::npos);
+    assert(sink.bytes.find("Slow") != std::string::npos || LOGGER_ENABLE_SOURCE_LOCATION == 0);
+    assert(DurationOf(sink.bytes, "empty") < slow_ns);
+    assert(sink.bytes.find("fast") == std::string::npos);
+    assert(sink.bytes.find("filtered") == std::string::npos);
+    return 0;
+}
@@ -0,0 +1,175 @@
+#include "../include/socket_sink.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+// Local stand-in for the log shipping daemon: accepts one peer and
+// collects everything it sends (one entry per packet for SOCK_SEQPACKET).
+class TestReceiver {
+  public:
+    TestReceiver(const char *path, int type) : path_(path) {
+        ::unlink(path);
+        listen_fd_ = ::socket(AF_UNIX, type, 0);
+        assert(listen_fd_ >= 0);
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+        assert(::bind(listen_fd_, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0);
+        assert(::listen(listen_fd_, 1) == 0);
+        thread_ = std::thread([this] { Run(); });
+    }
+
+    ~TestReceiver() {
+        Join();
+        ::close(listen_fd_);
+        ::unlink(path_);
+    }
+
+    void Join() {
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    std::string data;
+    std::vector<std::string> packets;
+
+  private:
+    void Run() {
+        const int fd = ::accept(listen_fd_, nullptr, nullptr);
+        assert(fd >= 0);
+        char buffer[256 * 1024];
+        for (;;) {
+            const ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+            if (n <= 0) {
+                break;
+            }
+            data.append(buffer, static_cast<std::size_t>(n));
+            packets.emplace_back(buffer, static_cast<std::size_t>(n));
+        }
+        ::close(fd);
+    }
+
+    const char *path_;
+    int listen_fd_;
+    std::thread thread_;
+};
+
+std::string MakeLines(int count) {
+    std::string out;
+    char line[96];
+    for (int i = 0; i < count; ++i) {
+        const int n = std::snprintf(line, sizeof(line), "[%d] [INFO] shipped line %d\n", 1000 + i, i);
+        out.append(line, static_cast<std::size_t>(n));
+    }
+    return out;
+}
+
+void WriteLines(logger::UnixSocketSink &sink, const std::string &lines) {
+    std::size_t start = 0;
+    while (start < lines.size()) {
+        const std::size_t end = lines.find('\n', start) + 1;
+        sink.Write(lines.data() + start, end - start);
+        start = end;
+    }
+}
+
+// Flush until the spill ring drains (the receiver runs concurrently).
+void DrainSink(logger::UnixSocketSink &sink) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (sink.PendingBytes() > 0 && std::chrono::steady_clock::now() < deadline) {
+        sink.Flush();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    assert(sink.PendingBytes() == 0);
+}
+
+} // namespace
+
+int main() {
+    char path[64];
+    std::snprintf(path, sizeof(path), "/tmp/lll_socket_test_%d.sock", static_cast<int>(::getpid()));
+    const std::string lines = MakeLines(20000);
+
+    // Stream: everything arrives in order.
+    {
+        TestReceiver receiver(path, SOCK_STREAM);
+        {
+            logger::UnixSocketSink sink(path);
+            assert(sink.IsConnected());
+            WriteLines(sink, lines);
+            DrainSink(sink);
+            assert(sink.Stats().dropped_bytes == 0);
+        }
+        receiver.Join();
+        assert(receiver.data == lines);
+    }
+
+    // Daemon starts late: output spills, then ships after reconnect.
+    {
+        ::unlink(path);
+        logger::UnixSocketSinkOptions options;
+        options.reconnect_initial_ms = 1;
+        options.reconnect_max_ms = 4;
+        auto sink = std::make_unique<logger::UnixSocketSink>(path, options);
+        assert(!sink->IsConnected());
+        const std::string early = MakeLines(100);
+        WriteLines(*sink, early);
+        sink->Flush();
+        assert(sink->PendingBytes() == early.size());
+
+        TestReceiver receiver(path, SOCK_STREAM);
+        DrainSink(*sink);
+        assert(sink->IsConnected());
+        assert(sink->Stats().connects == 1);
+        sink.reset();
+        receiver.Join();
+        assert(receiver.data == early);
+    }
+
+    // SeqPacket: every packet holds whole lines.
+    {
+        TestReceiver receiver(path, SOCK_SEQPACKET);
+        {
+            logger::UnixSocketSinkOptions options;
+            options.type = logger::UnixSocketSinkOptions::Type::SeqPacket;
+            options.batch_size = 4096;
+            logger::UnixSocketSink sink(path, options);
+            assert(sink.IsConnected());
+            WriteLines(sink, lines);
+            DrainSink(sink);
+        }
+        receiver.Join();
+        assert(receiver.data == lines);
+        assert(receiver.packets.size() > 1);
+        for (const std::string &packet : receiver.packets) {
+            assert(packet.size() <= 4096);
+            assert(packet.back() == '\n');
+        }
+    }
+
+    // No daemon and a tiny spill ring: new writes are dropped and counted, never blocked on.
+    {
+        ::unlink(path);
+        logger::UnixSocketSinkOptions options;
+        options.spill_capacity = 4096;
+        logger::UnixSocketSink sink(path, options);
+        WriteLines(sink, lines);
+        assert(sink.PendingBytes() <= 4096);
+        assert(sink.Stats().dropped_bytes + sink.PendingBytes() == lines.size());
+    }
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include "../include/formatter.h"
+#include "../include/logger.h"
+#include "../include/source_location.h"
+#include "test_sinks.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace {
+
+using logger_test::StringSink;
+
+#if LOGGER_HAS_STD_SOURCE_LOCATION
+// A wrapper that logs its caller's location, not its own.
+logger::LogResult Audit(logger::Logger<64> &log, const char *message,
+                        logger::SourceLocation where = logger::SourceLocation::Current()) {
+    return log.Log(logger::Level::Info, message, where);
+}
+#endif
+
+} // namespace
+
+int main() {
+    static_assert(logger::BasenameOffset("/home/build/src/feed.cpp") == 16, "last '/' wins");
+    static_assert(logger::BasenameOffset("C:\\build\\feed.cpp") == 9, "'\\' is a separator too");
+    static_assert(logger::BasenameOffset("feed.cpp") == 0, "no directory");
+    static_assert(logger::Basename("dir/")[0] == '\0', "trailing separator leaves an empty name");
+
+    const char *file = LLL_FILE_NAME;
+    assert(std::strcmp(file, "source_location_test.cpp") == 0);
+    const logger::SourceLocation here = LLL_HERE;
+    assert(here.file == file && here.line == __LINE__ - 1 && std::strcmp(here.function, "main") == 0);
+
+    logger::TextFormatter formatter;
+    StringSink sink;
+    int audit_line = 0;
+    {
+        auto log = std::make_unique<logger::Logger<64>>(formatter, sink);
+        assert(log->Log(logger::Level::Info, "plain", LLL_HERE) == logger::LogResult::Success);
+        assert(log->Log(logger::Level::Info, LLL_STATIC("literal"), LLL_HERE) == logger::LogResult::Success);
+        assert(log->LogFormat(logger::Level::Warn, LLL_HERE, "px=%d", 42) == logger::LogResult::Success);
+        LLL_LOG_SAMPLED(*log, logger::Level::Info, logger::SamplingMode::None, 1, "sampled %d", 1);
+#if LOGGER_HAS_STD_SOURCE_LOCATION
+        audit_line = __LINE__ + 1;
+        assert(Audit(*log, "audited") == logger::LogResult::Success);
+#endif
+        log->Start();
+    }
+    (void)audit_line;
+
+    // Only the file name reaches the output, never the directories.
+    assert(sink.bytes.find("tests/") == std::string::npos);
+#if LOGGER_ENABLE_SOURCE_LOCATION
+    assert(sink.bytes.find(" source_location_test.cpp:") != std::string::npos);
+    assert(sink.bytes.find(" main plain\n") != std::string::npos);
+    assert(sink.bytes.find(" main literal\n") != std::string::npos);
+    assert(sink.bytes.find(" main px=42\n") != std::string::npos);
+    assert(sink.bytes.find(" main sampled 1\n") != std::string::npos);
+#if LOGGER_HAS_STD_SOURCE_LOCATION
+    const std::string audited = "source_location_test.cpp:" + std::to_string(audit_line) + ' ';
+    assert(sink.bytes.find(audited) != std::string::npos);
+#endif
+#else
+    // Records do not store the location; the messages still arrive.
+    assert(sink.bytes.find("source_location_test.cpp") == std::string::npos);
+    assert(sink.bytes.find(" main ") == std::string::npos);
+    assert(sink.bytes.find(" plain\n") != std::string::npos);
+    assert(sink.bytes.find(" literal\n") != std::string::npos);
+    assert(sink.bytes.find(" px=42\n") != std::string::npos);
+    assert(sink.bytes.find(" sampled 1\n") != std::string::npos);
+#endif
+#if LOGGER_HAS_STD_SOURCE_LOCATION
+    assert(sink.bytes.find(" audited\n") != std::string::npos);
+#endif
+    return 0;
+}
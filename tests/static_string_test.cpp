@@ -0,0 +1,80 @@
+#include "../include/context.h"
+#include "../include/formatter.h"
+#include "../include/logger.h"
+#include "../include/static_string.h"
+#include "test_sinks.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace {
+
+using logger_test::HasLine;
+using logger_test::StringSink;
+
+#define LONG_LITERAL_16 "0123456789abcdef"
+#define LONG_LITERAL_256                                                                                               \
+    LONG_LITERAL_16 LONG_LITERAL_16 LONG_LITERAL_16 LONG_LITERAL_16 LONG_LITERAL_16 LONG_LITERAL_16 LONG_LITERAL_16    \
+        LONG_LITERAL_16 LONG_LITERAL_16 LONG_LITERAL_16 LONG_LITERAL_16 LONG_LITERAL_16 LONG_LITERAL_16                \
+            LONG_LITERAL_16 LONG_LITERAL_16 LONG_LITERAL_16
+#define LONG_LITERAL LONG_LITERAL_256 LONG_LITERAL_256 LONG_LITERAL_256 LONG_LITERAL_256 LONG_LITERAL_256
+
+} // namespace
+
+int main() {
+    using namespace logger::literals;
+
+    // A StaticString is the literal itself, not a copy.
+    static const char kAccepted[] = "order accepted";
+    constexpr logger::StaticString suffix = "order accepted"_lll;
+    static_assert(suffix.size() == 14, "length excludes the terminator");
+    const logger::StaticString macro = LLL_STATIC("order accepted");
+    assert(macro.size() == sizeof(kAccepted) - 1);
+    assert(std::strcmp(macro.data(), kAccepted) == 0);
+    static_assert(sizeof(LONG_LITERAL) - 1 > LOGGER_MAX_MESSAGE_SIZE, "literal must not fit one slot");
+
+    char buffer[32];
+    std::memcpy(buffer, "copied view|tail", 17);
+
+    logger::TextFormatter formatter;
+    StringSink sink;
+    {
+        auto log = std::make_unique<logger::Logger<64>>(formatter, sink);
+        assert(log->Info("literal by suffix"_lll) == logger::LogResult::Success);
+        assert(log->Log(logger::Level::Warn, LLL_STATIC("literal by macro"), __FILE__, __LINE__, __func__) ==
+               logger::LogResult::Success);
+
+        // Literals are never truncated and never span: one slot, whatever the length.
+        assert(log->Info(LLL_STATIC(LONG_LITERAL)) == logger::LogResult::Success);
+        assert(log->PendingCount() == 3);
+
+        // A string_view is copied at the call, so the caller may reuse its buffer.
+        assert(log->Log(logger::Level::Info, std::string_view(buffer, 11)) == logger::LogResult::Success);
+        std::memset(buffer, 'x', sizeof(buffer));
+        assert(log->PendingCount() == 4);
+
+        {
+            LLL_CONTEXT("order", 7);
+            assert(log->Info("literal with context"_lll) == logger::LogResult::Success);
+        }
+
+        log->SetLevel(logger::Level::Error);
+        assert(log->Info("filtered"_lll) == logger::LogResult::Filtered);
+        log->Start();
+    }
+    assert(HasLine(sink.bytes, "literal by suffix"));
+    assert(HasLine(sink.bytes, "literal by macro"));
+    assert(HasLine(sink.bytes, LONG_LITERAL));
+    assert(HasLine(sink.bytes, "copied view"));
+#if LOGGER_ENABLE_CONTEXT
+    assert(HasLine(sink.bytes, "[order=7] literal with context"));
+#else
+    assert(HasLine(sink.bytes, "literal with context"));
+#endif
+    assert(sink.bytes.find("filtered") == std::string::npos);
+    return 0;
+}
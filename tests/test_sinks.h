@@ -0,0 +1,53 @@
+/**
+ * @file test_sinks.h
+ * @brief Capture sink and output helpers shared by the tests
+ */
+
+#ifndef LOGGER_TESTS_TEST_SINKS_H
+#define LOGGER_TESTS_TEST_SINKS_H
+
+#include "../include/sink.h"
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+
+namespace logger_test {
+
+/**
+ * @brief Sink that keeps everything written to it in memory
+ *
+ * `bytes` and `writes` are for reading once the logger has stopped;
+ * Snapshot() may be called while the consumer thread is still writing.
+ */
+class StringSink final : public logger::Sink {
+  public:
+    void Write(const char *data, std::size_t len) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        bytes.append(data, len);
+        ++writes;
+    }
+    void Flush() override {}
+
+    std::string Snapshot() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return bytes;
+    }
+
+    std::string bytes;
+    std::size_t writes = 0;
+
+  private:
+    std::mutex mutex_;
+};
+
+/**
+ * @brief true if some line of `output` ends with " <payload>"
+ */
+inline bool HasLine(const std::string &output, const std::string &payload) {
+    return output.find(' ' + payload + '\n') != std::string::npos;
+}
+
+} // namespace logger_test
+
+#endif // LOGGER_TESTS_TEST_SINKS_H
@@ -0,0 +1,262 @@
+#include "../include/binary_log.h"
+#include "../include/formatter.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <queue>
+#include <string>
+#include <vector>
+
+// lll_merge: interleave N log files (binary or text, any mix) into one
+// stream ordered by timestamp.
+//
+//   lll_merge [--window N] [--source] [--stats] FILE...
+//
+// Both formats are put on the same timeline: text lines start with
+// "[tsc / ticks_per_ns]" of the writing process, and binary records are
+// converted with the calibration stored in their file header, then printed
+// in the same text layout. Files on one host share the TSC, so records of
+// different processes and shards line up.
+//
+// Memory is bounded: one decoded block per binary file, one line per text
+// file, plus a reorder window of N records (default 4096) that absorbs the
+// small disorder of loggers sharing one sink.
+
+namespace {
+
+struct Entry {
+    std::uint64_t key_ns;
+    std::string text; // newline-terminated
+};
+
+class Source {
+  public:
+    virtual ~Source() = default;
+    // Next record of this file, in file order; false at end of file.
+    virtual bool Next(Entry &entry) = 0;
+};
+
+// Text output of TextFormatter: "[ns] [LEVEL] ...". Lines that do not
+// start with a timestamp (multi-line messages) stay with their record.
+class TextSource final : public Source {
+  public:
+    explicit TextSource(const char *path) {
+        in_.rdbuf()->pubsetbuf(buffer_.get(), kBufferSize); // before open() to take effect
+        in_.open(path, std::ios::binary);
+        has_line_ = ReadLine();
+    }
+
+    bool Open() const {
+        return static_cast<bool>(in_) || has_line_;
+    }
+
+    bool Next(Entry &entry) override {
+        while (has_line_ && !ParseKey(line_, entry.key_ns)) {
+            has_line_ = ReadLine(); // orphaned lines before the first record
+        }
+        if (!has_line_) {
+            return false;
+        }
+        entry.text = line_;
+        std::uint64_t ignored = 0;
+        while ((has_line_ = ReadLine()) && !ParseKey(line_, ignored)) {
+            entry.text += line_;
+        }
+        return true;
+    }
+
+  private:
+    static constexpr std::size_t kBufferSize = 1 << 20;
+
+    bool ReadLine() {
+        if (!std::getline(in_, line_)) {
+            return false;
+        }
+        line_ += '\n';
+        return true;
+    }
+
+    static bool ParseKey(const std::string &line, std::uint64_t &key) {
+        if (line.size() < 3 || line[0] != '[' || line[1] < '0' || line[1] > '9') {
+            return false;
+        }
+        char *end = nullptr;
+        key = std::strtoull(line.c_str() + 1, &end, 10);
+        return end && *end == ']';
+    }
+
+    std::unique_ptr<char[]> buffer_{new char[kBufferSize]};
+    std::ifstream in_;
+    std::string line_;
+    bool has_line_ = false;
+};
+
+// BinaryFileSink output, decoded one block at a time.
+class BinarySource final : public Source {
+  public:
+    bool Open(const char *path) {
+        return reader_.Open(path);
+    }
+
+    bool Next(Entry &entry) override {
+        while (pos_ == decoded_.size()) {
+            if (block_ == reader_.BlockCount()) {
+                return false;
+            }
+            decoded_.clear();
+            pos_ = 0;
+            if (!reader_.ForEachRecord(block_, [&](const logger::BinaryRecordView &record) { Decode(record); })) {
+                std::fprintf(stderr, "lll_merge: corrupt block %zu skipped after %zu records\n", block_,
+                             decoded_.size());
+            }
+            ++block_;
+        }
+        entry = std::move(decoded_[pos_++]);
+        return true;
+    }
+
+  private:
+    // Same layout as TextFormatter, with this file's calibration.
+    void Decode(const logger::BinaryRecordView &record) {
+        logger::TextLineFields fields{};
+        fields.timestamp_ns =
+            static_cast<std::uint64_t>(static_cast<double>(record.timestamp) / reader_.TicksPerNanosecond());
+        fields.level = record.level;
+        fields.sample_rate = record.sample_rate;
+        fields.has_thread_id = LOGGER_ENABLE_THREAD_ID != 0;
+        fields.thread_id = record.thread_id;
+        fields.file = record.file[0] != '\0' ? record.file : nullptr;
+        fields.function = record.function;
+        fields.line = record.line;
+        fields.message = record.message;
+        fields.message_length = record.message_length;
+        fields.hex_dump = record.hex_dump;
+        char line[logger::kFormatScratchSize];
+        decoded_.push_back(Entry{fields.timestamp_ns, std::string(line, logger::FormatTextLine(fields, line, sizeof(line)))});
+    }
+
+    logger::BinaryLogReader reader_;
+    std::size_t block_ = 0;
+    std::vector<Entry> decoded_;
+    std::size_t pos_ = 0;
+};
+
+struct Head {
+    std::uint64_t key_ns;
+    std::uint64_t seq; // ties keep input order
+    std::size_t source;
+    std::string text;
+};
+
+struct Later {
+    bool operator()(const Head &a, const Head &b) const {
+        return a.key_ns != b.key_ns ? a.key_ns > b.key_ns : a.seq > b.seq;
+    }
+};
+
+void Usage() {
+    std::fprintf(stderr, "usage: lll_merge [--window N] [--source] [--stats] FILE...\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    std::size_t window = 4096;
+    bool tag_source = false;
+    bool stats = false;
+    std::vector<const char *> paths;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--window") == 0 && i + 1 < argc) {
+            window = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--source") == 0) {
+            tag_source = true;
+        } else if (std::strcmp(argv[i], "--stats") == 0) {
+            stats = true;
+        } else if (argv[i][0] == '-') {
+            Usage();
+            return 2;
+        } else {
+            paths.push_back(argv[i]);
+        }
+    }
+    if (paths.empty()) {
+        Usage();
+        return 2;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::unique_ptr<Source>> sources;
+    for (const char *path : paths) {
+        auto binary = std::make_unique<BinarySource>();
+        if (binary->Open(path)) {
+            sources.push_back(std::move(binary));
+            continue;
+        }
+        auto text = std::make_unique<TextSource>(path);
+        if (!text->Open()) {
+            std::fprintf(stderr, "lll_merge: cannot read '%s'\n", path);
+            return 1;
+        }
+        sources.push_back(std::move(text));
+    }
+
+    // K-way merge: one head per source, then a bounded reorder window.
+    std::priority_queue<Head, std::vector<Head>, Later> heads;
+    std::priority_queue<Head, std::vector<Head>, Later> pending;
+    std::uint64_t seq = 0;
+    std::uint64_t emitted = 0;
+    std::uint64_t late = 0;
+    std::uint64_t last_key = 0;
+    Entry entry;
+    auto pull = [&](std::size_t source) {
+        if (sources[source]->Next(entry)) {
+            heads.push(Head{entry.key_ns, seq++, source, std::move(entry.text)});
+        }
+    };
+    auto emit = [&](const Head &head) {
+        if (head.key_ns < last_key) {
+            ++late; // disorder wider than the window
+        }
+        last_key = std::max(last_key, head.key_ns);
+        if (tag_source) {
+            std::fputs(paths[head.source], stdout);
+            std::fputs(": ", stdout);
+        }
+        std::fwrite(head.text.data(), 1, head.text.size(), stdout);
+        ++emitted;
+    };
+
+    for (std::size_t i = 0; i < sources.size(); ++i) {
+        pull(i);
+    }
+    while (!heads.empty()) {
+        // Moving the text out of top() is safe: pop() only compares key_ns/seq.
+        Head head = std::move(const_cast<Head &>(heads.top()));
+        heads.pop();
+        pull(head.source);
+        pending.push(std::move(head));
+        if (pending.size() > window) {
+            emit(pending.top());
+            pending.pop();
+        }
+    }
+    while (!pending.empty()) {
+        emit(pending.top());
+        pending.pop();
+    }
+    std::fflush(stdout);
+
+    if (stats) {
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::fprintf(stderr, "lll_merge: %zu files, %llu records, %llu out of order beyond window, %.2f ms\n",
+                     sources.size(), static_cast<unsigned long long>(emitted), static_cast<unsigned long long>(late),
+                     ms);
+    }
+    return 0;
+}
@@ -0,0 +1,260 @@
+#include "../include/binary_log.h"
+#include "../include/level.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+// lll_query: time-range / level / thread queries over a BinaryFileSink file.
+//
+//   lll_query FILE [--from T] [--to T] [--level LEVEL] [--thread TID] [--jobs N] [--stats]
+//
+// T is "YYYY-MM-DDTHH:MM:SS[.frac]" (UTC), "HH:MM:SS[.frac]" (UTC, on the
+// day of the first record) or "@<unix-ns>". Only blocks whose index entry
+// overlaps the range and holds a wanted level are decoded, in parallel.
+
+namespace {
+
+constexpr std::uint64_t kNsPerSecond = 1000000000ull;
+constexpr std::size_t kBlocksPerWindow = 1024; // decoded before output, bounds memory
+
+struct Query {
+    const char *path = nullptr;
+    const char *from = nullptr;
+    const char *to = nullptr;
+    logger::Level min_level = logger::Level::Trace;
+    bool by_thread = false;
+    std::uint64_t thread_id = 0;
+    unsigned jobs = 0;
+    bool stats = false;
+};
+
+void Usage() {
+    std::fprintf(stderr, "usage: lll_query FILE [--from T] [--to T] [--level LEVEL] [--thread TID] [--jobs N] [--stats]\n"
+                         "  T: YYYY-MM-DDTHH:MM:SS[.frac] | HH:MM:SS[.frac] (UTC) | @unix_ns\n");
+}
+
+bool ParseLevel(const char *text, logger::Level &level) {
+    for (std::size_t i = 0; i < logger::kLevelCount; ++i) {
+        const logger::Level candidate = static_cast<logger::Level>(i);
+        const char *name = logger::LevelToString(candidate);
+        std::size_t n = 0;
+        while (name[n] && text[n] && std::toupper(static_cast<unsigned char>(text[n])) == name[n]) {
+            ++n;
+        }
+        if (name[n] == '\0' && text[n] == '\0') {
+            level = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Days since 1970-01-01 for a proleptic Gregorian date (Howard Hinnant's algorithm).
+std::int64_t DaysFromCivil(std::int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const std::int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<std::int64_t>(doe) - 719468;
+}
+
+// Parses "HH:MM:SS[.frac]" at `text`; returns nanoseconds into the day.
+bool ParseClock(const char *text, std::uint64_t &ns) {
+    unsigned hour = 0;
+    unsigned minute = 0;
+    unsigned second = 0;
+    int used = 0;
+    if (std::sscanf(text, "%2u:%2u:%2u%n", &hour, &minute, &second, &used) != 3 || hour > 23 || minute > 59 ||
+        second > 60) {
+        return false;
+    }
+    ns = ((hour * 60ull + minute) * 60ull + second) * kNsPerSecond;
+    const char *p = text + used;
+    if (*p == '.') {
+        std::uint64_t scale = kNsPerSecond / 10;
+        for (++p; *p >= '0' && *p <= '9'; ++p, scale /= 10) {
+            ns += static_cast<std::uint64_t>(*p - '0') * scale;
+        }
+    }
+    return *p == '\0' || *p == 'Z';
+}
+
+bool ParseTime(const char *text, std::uint64_t day_start_ns, std::uint64_t &unix_ns) {
+    if (text[0] == '@') {
+        char *end = nullptr;
+        unix_ns = std::strtoull(text + 1, &end, 10);
+        return end && *end == '\0';
+    }
+    int year = 0;
+    unsigned month = 0;
+    unsigned day = 0;
+    int used = 0;
+    if (std::sscanf(text, "%4d-%2u-%2u%n", &year, &month, &day, &used) == 3 && (text[used] == 'T' || text[used] == ' ')) {
+        std::uint64_t clock_ns = 0;
+        if (month < 1 || month > 12 || day < 1 || day > 31 || !ParseClock(text + used + 1, clock_ns)) {
+            return false;
+        }
+        const std::int64_t days = DaysFromCivil(year, month, day);
+        if (days < 0) {
+            return false;
+        }
+        unix_ns = static_cast<std::uint64_t>(days) * 86400ull * kNsPerSecond + clock_ns;
+        return true;
+    }
+    std::uint64_t clock_ns = 0;
+    if (!ParseClock(text, clock_ns)) {
+        return false;
+    }
+    unix_ns = day_start_ns + clock_ns;
+    return true;
+}
+
+bool ParseArgs(int argc, char **argv, Query &query) {
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(arg, "--from") == 0 && has_value) {
+            query.from = argv[++i];
+        } else if (std::strcmp(arg, "--to") == 0 && has_value) {
+            query.to = argv[++i];
+        } else if (std::strcmp(arg, "--level") == 0 && has_value) {
+            if (!ParseLevel(argv[++i], query.min_level)) {
+                std::fprintf(stderr, "lll_query: unknown level '%s'\n", argv[i]);
+                return false;
+            }
+        } else if (std::strcmp(arg, "--thread") == 0 && has_value) {
+            query.by_thread = true;
+            query.thread_id = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(arg, "--jobs") == 0 && has_value) {
+            query.jobs = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(arg, "--stats") == 0) {
+            query.stats = true;
+        } else if (arg[0] != '-' && !query.path) {
+            query.path = arg;
+        } else {
+            return false;
+        }
+    }
+    return query.path != nullptr;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Query query;
+    if (!ParseArgs(argc, argv, query)) {
+        Usage();
+        return 2;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    logger::BinaryLogReader reader;
+    if (!reader.Open(query.path)) {
+        std::fprintf(stderr, "lll_query: cannot open '%s' as a binary log\n", query.path);
+        return 1;
+    }
+    if (reader.BlockCount() == 0) {
+        return 0;
+    }
+
+    // Clock-only bounds refer to the UTC day of the first record.
+    const std::uint64_t first_ns = reader.TscToUnixNs(reader.Block(0).min_tsc);
+    const std::uint64_t day_start_ns = first_ns - first_ns % (86400ull * kNsPerSecond);
+    std::uint64_t from_ns = 0;
+    std::uint64_t to_ns = ~std::uint64_t{0};
+    if (query.from && !ParseTime(query.from, day_start_ns, from_ns)) {
+        std::fprintf(stderr, "lll_query: bad time '%s'\n", query.from);
+        return 2;
+    }
+    if (query.to && !ParseTime(query.to, day_start_ns, to_ns)) {
+        std::fprintf(stderr, "lll_query: bad time '%s'\n", query.to);
+        return 2;
+    }
+    // Blocks are selected in TSC units with a little slack for conversion
+    // rounding; records are then filtered on the same wall-clock values that are printed.
+    constexpr std::uint64_t kSlackTicks = 4096;
+    const std::uint64_t from_tsc = query.from ? reader.UnixNsToTsc(from_ns) : 0;
+    const std::uint64_t to_tsc = query.to ? reader.UnixNsToTsc(to_ns) : ~std::uint64_t{0};
+
+    // Index lookup: time range by binary search, then the level bitmaps.
+    std::size_t first = 0;
+    std::size_t last = 0;
+    reader.FindBlocks(from_tsc > kSlackTicks ? from_tsc - kSlackTicks : 0,
+                      to_tsc < ~kSlackTicks ? to_tsc + kSlackTicks : ~std::uint64_t{0}, first, last);
+    const unsigned wanted_levels = 0xFFu << logger::LevelToInt(query.min_level);
+    std::vector<std::size_t> candidates;
+    for (std::size_t block = first; block < last; ++block) {
+        if (reader.Block(block).level_mask & wanted_levels) {
+            candidates.push_back(block);
+        }
+    }
+
+    unsigned jobs = query.jobs != 0 ? query.jobs : std::max(1u, std::thread::hardware_concurrency());
+    jobs = static_cast<unsigned>(std::min<std::size_t>(jobs, std::max<std::size_t>(candidates.size(), 1)));
+
+    std::atomic<std::uint64_t> matched{0};
+    std::atomic<bool> corrupt{false};
+    std::vector<std::string> outputs(std::min(candidates.size(), kBlocksPerWindow));
+    for (std::size_t window = 0; window < candidates.size(); window += kBlocksPerWindow) {
+        const std::size_t window_size = std::min(kBlocksPerWindow, candidates.size() - window);
+        std::atomic<std::size_t> next{0};
+        auto decode = [&] {
+            char line[logger::kFormatScratchSize];
+            std::uint64_t local_matched = 0;
+            for (std::size_t i = next.fetch_add(1); i < window_size; i = next.fetch_add(1)) {
+                std::string &out = outputs[i];
+                out.clear();
+                const bool ok = reader.ForEachRecord(candidates[window + i], [&](const logger::BinaryRecordView &record) {
+                    const std::uint64_t unix_ns = reader.TscToUnixNs(record.timestamp);
+                    if (unix_ns < from_ns || unix_ns > to_ns || !logger::ShouldLog(record.level, query.min_level) ||
+                        (query.by_thread && record.thread_id != query.thread_id)) {
+                        return;
+                    }
+                    out.append(line, reader.FormatText(record, line, sizeof(line)));
+                    ++local_matched;
+                });
+                if (!ok) {
+                    corrupt.store(true, std::memory_order_relaxed);
+                }
+            }
+            matched.fetch_add(local_matched, std::memory_order_relaxed);
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned j = 1; j < jobs; ++j) {
+            workers.emplace_back(decode);
+        }
+        decode();
+        for (std::thread &worker : workers) {
+            worker.join();
+        }
+        // Output in file order, whichever worker decoded the block.
+        for (std::size_t i = 0; i < window_size; ++i) {
+            std::fwrite(outputs[i].data(), 1, outputs[i].size(), stdout);
+        }
+    }
+    std::fflush(stdout);
+
+    if (corrupt.load()) {
+        std::fprintf(stderr, "lll_query: some blocks are corrupt; their remaining records were skipped\n");
+    }
+    if (query.stats) {
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::fprintf(stderr, "lll_query: %zu blocks, %zu in range, %zu decoded, %llu records matched, %u jobs, %.2f ms%s\n",
+                     reader.BlockCount(), last - first, candidates.size(),
+                     static_cast<unsigned long long>(matched.load()), jobs, ms,
+                     reader.HasFooterIndex() ? "" : " (index rebuilt: no footer)");
+    }
+    return corrupt.load() ? 1 : 0;
+}